@@ -9,6 +9,54 @@
 
 namespace Collision
 {
+    // décor statique d'un niveau en cases pleines, testé sans objet Wall (voir LEVEL_TILE_COLLISION)
+    struct TileMap
+    {
+        const std::vector<std::vector<bool>>* grid = nullptr;
+        Vector2D origin;        // coin haut-gauche de la case (0, 0) dans le monde
+        float cellSize = 1.0f;
+
+        bool Solid(int x, int y) const
+        {
+            if (!grid || y < 0 || y >= (int)grid->size() || x < 0 || x >= (int)(*grid)[y].size())
+                return false;
+            return (*grid)[y][x];
+        }
+    };
+
+    // grille du niveau courant, mise à jour par la boucle principale ; vide si le décor est fait d'objets Wall
+    inline TileMap& CurrentTiles()
+    {
+        static TileMap tiles;
+        return tiles;
+    }
+
+    // distance jusqu'à la première case pleine sur le rayon (parcours case par case), maxDistance si aucune
+    inline float RaycastTiles(const TileMap& tiles, const Vector2D& origin, const Vector2D& dir, float maxDistance)
+    {
+        if (!tiles.grid)
+            return maxDistance;
+
+        float gx = (origin.x - tiles.origin.x) / tiles.cellSize;
+        float gy = (origin.y - tiles.origin.y) / tiles.cellSize;
+        int x = (int)std::floor(gx), y = (int)std::floor(gy);
+        int stepX = dir.x > 0.0f ? 1 : -1, stepY = dir.y > 0.0f ? 1 : -1;
+        float tDeltaX = std::fabs(dir.x) > 1e-6f ? tiles.cellSize / std::fabs(dir.x) : FLT_MAX;
+        float tDeltaY = std::fabs(dir.y) > 1e-6f ? tiles.cellSize / std::fabs(dir.y) : FLT_MAX;
+        float tMaxX = tDeltaX == FLT_MAX ? FLT_MAX : (dir.x > 0.0f ? (x + 1 - gx) : (gx - x)) * tDeltaX;
+        float tMaxY = tDeltaY == FLT_MAX ? FLT_MAX : (dir.y > 0.0f ? (y + 1 - gy) : (gy - y)) * tDeltaY;
+
+        float t = 0.0f;
+        while (t <= maxDistance)
+        {
+            if (tiles.Solid(x, y))
+                return t;
+            if (tMaxX < tMaxY) { t = tMaxX; tMaxX += tDeltaX; x += stepX; }
+            else               { t = tMaxY; tMaxY += tDeltaY; y += stepY; }
+        }
+        return maxDistance;
+    }
+
     inline std::vector<Object*> Raycast(
         const Vector2D&               origin,
         float                         angleRad,
@@ -24,6 +72,10 @@ namespace Collision
     
         // Direction normalisée du rayon
         Vector2D dir{ std::cos(angleRad), std::sin(angleRad) };
+
+        // le décor en cases arrête le rayon comme le ferait un Wall
+        if (stopFlagsMask & Flag_Wall)
+            maxDistance = RaycastTiles(CurrentTiles(), origin, dir, maxDistance);
     
         for (auto* o : objects) {
             if (!o->IsActive() || !o->collision) 
@@ -171,6 +223,59 @@ namespace Collision
         return true;
     }
 
+    /**
+     * Pénétration de la boîte de l'objet dans les cases pleines, la plus profonde par axe (0 si aucune).
+     * Une face de case collée à une autre case pleine est ignorée : un objet qui glisse le long d'un mur
+     * n'accroche pas les jointures entre cases.
+     */
+    inline Vector2D TilePenetration(const Object* o, const TileMap& tiles)
+    {
+        Vector2D c = o->GetWorldPosition();
+        Vector2D e = o->collisionDelimiter;
+        if (o->delimiterAffectedByRotation)
+        {
+            float r = o->GetRotation() * DEG2RAD;
+            float cr = std::fabs(std::cos(r)), sr = std::fabs(std::sin(r));
+            e = { cr * e.x + sr * e.y, sr * e.x + cr * e.y };
+        }
+
+        float cs = tiles.cellSize, half = cs * 0.5f;
+        int x0 = (int)std::floor((c.x - e.x - tiles.origin.x) / cs);
+        int x1 = (int)std::ceil((c.x + e.x - tiles.origin.x) / cs) - 1;
+        int y0 = (int)std::floor((c.y - e.y - tiles.origin.y) / cs);
+        int y1 = (int)std::ceil((c.y + e.y - tiles.origin.y) / cs) - 1;
+
+        Vector2D push{ 0.0f, 0.0f }; // direction objet -> mur, longueur = pénétration
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                if (!tiles.Solid(x, y))
+                    continue;
+
+                float dx = tiles.origin.x + x * cs + half - c.x;
+                float dy = tiles.origin.y + y * cs + half - c.y;
+                float px = e.x + half - std::fabs(dx);
+                float py = e.y + half - std::fabs(dy);
+                if (px <= 0.0f || py <= 0.0f)
+                    continue;
+
+                int sx = dx > 0.0f ? 1 : -1, sy = dy > 0.0f ? 1 : -1;
+                bool freeX = !tiles.Solid(x - sx, y);
+                bool freeY = !tiles.Solid(x, y - sy);
+                if (freeX && (!freeY || px <= py))
+                {
+                    if (px > std::fabs(push.x)) push.x = sx * px;
+                }
+                else if (freeY)
+                {
+                    if (py > std::fabs(push.y)) push.y = sy * py;
+                }
+            }
+        }
+        return push;
+    }
+
     class CollisionSystem
     {
     public:
@@ -183,6 +288,8 @@ namespace Collision
         // Call this once per frame after updating all objects
         void Update()
         {
+            ResolveTiles();
+
             current.clear();
             // Broad-phase: brute-force SAT with MTV
             for (size_t i = 0; i < objects.size(); ++i)
@@ -227,6 +334,26 @@ namespace Collision
         }
 
     private:
+        // objets mobiles contre le décor en cases : un appel à OnTileCollision par axe touché
+        void ResolveTiles()
+        {
+            const TileMap& tiles = CurrentTiles();
+            if (!tiles.grid)
+                return;
+
+            for (Object* o : objects)
+            {
+                if (!o->IsActive() || !o->collision || o->HasFlag(Flag_Wall) || o->HasFlag(Flag_LevelWall) || o->HasFlag(Flag_Exit))
+                    continue;
+
+                Vector2D push = TilePenetration(o, tiles);
+                if (push.x != 0.0f)
+                    o->OnTileCollision({ push.x > 0.0f ? 1.0f : -1.0f, 0.0f }, std::fabs(push.x));
+                if (push.y != 0.0f)
+                    o->OnTileCollision({ 0.0f, push.y > 0.0f ? 1.0f : -1.0f }, std::fabs(push.y));
+            }
+        }
+
         std::vector<Object*> objects;
         std::unordered_set<CollisionPair, PairHash> previous, current;
     };
@@ -11,13 +11,14 @@ public:
 EndVideo()
     {
         SetPosition(0.0f, 0.0f);
+        screenSpace = true;
         delimiterAffectedByRotation = false;
         collision = false;
     }
 
     void Init(SDL_Renderer* renderer)
     {
-        video = std::make_unique<AnimationSystem>(renderer, "EndVideo/");
+        video = std::make_unique<VideoStream>(renderer, "EndVideo/");
         
         size_t frame_count_1 = 40, frame_count_2 = 16, frame_count_3 = 34;
         std::vector<std::string> paths1;
@@ -48,16 +49,15 @@ EndVideo()
             else number = std::string("0") + std::to_string(i);
             paths3.push_back("bosskill/boss_death_" + number + ".png");
         }
-        video->SetEntries({  { "end_kill", paths1, 0.08f },   { "boss", paths2, 0.1f },   { "boss_kill", paths3, 0.1f } });
-        video->SetAnimation("end_kill", false);
+        video->SetClips({  { "end_kill", paths1, 0.08f },   { "boss", paths2, 0.1f },   { "boss_kill", paths3, 0.1f } });
+        video->Play("end_kill", false);
 
         timeBeforeExit = 0.0f;
     }
 
     void StartVideo(std::string id)
     {
-        video->ResetAnimation();
-        video->SetAnimation(id, false);
+        video->Play(id, false, true);
         SoundManager::Instance().PlaySound(id, false, 1.0f);
         timeBeforeExit = video->EntryTime() + 0.35f;
     }
@@ -84,17 +84,18 @@ EndVideo()
 
         if (End()) return;
 
-        SDL_Texture* tex = video->Next(Time::DeltaTime());
+        const SpriteFrame* frame = video->NextFrame(Time::DeltaTime());
+        if (!frame) return;
 
         int w, h;
         SDL_GetRendererOutputSize(renderer, &w, &h);
 
-        SDL_Rect rect;
+        SDL_FRect rect;
         rect.w = w;
         rect.h = h;
         rect.x = 0;
         rect.y = 0;
-        SDL_RenderCopy(renderer, tex, nullptr, &rect);
+        SpriteBatch::Instance().Draw(renderer, *frame, rect);
     }
 
     bool End()
@@ -103,7 +104,7 @@ EndVideo()
     }
 
 private:
-    std::unique_ptr<AnimationSystem> video;
+    std::unique_ptr<VideoStream> video;
     bool debug_show = true;
     float timeBeforeExit = 0.0f;
 };
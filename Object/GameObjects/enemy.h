@@ -9,9 +9,24 @@
 
 using Grid = std::vector<std::vector<bool>>;
 
-class Enemy : public Entity
+/**
+ * Modèle d'ennemi résolu une fois (animations partagées, indices de clips, caractéristiques) :
+ * les instances créées à partir de lui ne font plus aucune recherche par nom.
+ */
+struct EnemyPrefab
+{
+    bool boss = false;
+    float maxHP = ENEMY_MAX_HP;
+    float attackSpeed = ENEMY_ATTACK_SPEED;
+    std::shared_ptr<const AnimationSet> animations;
+    int idleClip = -1, walkClip = -1, attackClip = -1, chaseClip = -1, deadClip = -1;
+};
+
+class Enemy : public TypedObject<Enemy, Entity>
 {
 public:
+    static constexpr uint32_t TYPE = Type_Enemy;
+
     Enemy()
     {
         SetFlags(ObjectFlag::Flag_Enemy);
@@ -26,122 +41,155 @@ public:
 
         computingPath_ = false;
         pathIndex_ = 0;
-        grid_ = nullptr;
+        nav_ = nullptr;
 
         is_chasing = false;
         target_was_player = false;
     }
 
+    static const char *SpriteFolder(bool isBoss)
+    {
+        return isBoss ? "BOSS/" : "ENEMY1/";
+    }
+
+    // clips de l'ennemi ou du boss, aussi utilisés pour précharger l'atlas (AnimationSet::AtlasPaths)
+    static std::vector<AnimationEntryTmp> Animations(bool isBoss)
+    {
+        if (!isBoss)
+        {
+            return {{"idle",
+                     {"enemy1_idle.png"},
+                     FRAME_DURATION},
+
+                    {"walk",
+                     {
+                         "enemy1_idle.png",
+                         "enemy1_idle_step_left_1.png",
+                         "enemy1_idle_step_left_2.png",
+                         "enemy1_idle_step_right_1.png",
+                         "enemy1_idle_step_right_2.png",
+                     },
+                     FRAME_DURATION,
+                     {0, 1, 2, 1, 0, 3, 4, 3}},
+
+                    {"attack",
+                     {"enemy1_attack_0.png",
+                      "enemy1_attack_1.png",
+                      "enemy1_attack_2.png",
+                      "enemy1_after_attack_0.png",
+                      "enemy1_after_attack_1.png",
+                      "enemy1_after_attack_2.png"},
+                     ATTACK_FRAME_DURATION},
+
+                    {"chase",
+                     {
+                         "enemy1_ready.png",
+                         "enemy1_step_left_1.png",
+                         "enemy1_step_left_2.png",
+                         "enemy1_step_right_1.png",
+                         "enemy1_step_right_2.png",
+                     },
+                     FRAME_DURATION * PLAYER_SPEED_SPRINT_MUL,
+                     {0, 1, 2, 1, 0, 3, 4, 3}},
+
+                    {"dead",
+                     {
+                         "enemy1_death1_1.png",
+                         "enemy1_death1_2.png",
+                         "enemy1_death1_3.png",
+                         "enemy1_death1_4.png",
+                         "enemy1_death1_5.png",
+                         "enemy1_death1_6.png",
+                     },
+                     FRAME_DURATION}};
+        }
+        return {{"idle",
+                 {"boss_idle.png"},
+                 FRAME_DURATION},
+
+                {"walk",
+                 {
+                     "boss_idle.png",
+                     "boss_step_left_1.png",
+                     "boss_step_left_2.png",
+                     "boss_step_right_1.png",
+                     "boss_step_right_2.png",
+                 },
+                 FRAME_DURATION,
+                 {0, 1, 2, 1, 0, 3, 4, 3}},
+
+                {"attack",
+                 {"boss_attack_0.png",
+                  "boss_attack_1.png",
+                  "boss_attack_2.png",
+                  "boss_after_attack_0.png",
+                  "boss_after_attack_1.png",
+                  "boss_after_attack_2.png"},
+                 ATTACK_FRAME_DURATION},
+
+                {"chase",
+                 {
+                     "boss_idle.png",
+                     "boss_step_left_1.png",
+                     "boss_step_left_2.png",
+                     "boss_step_right_1.png",
+                     "boss_step_right_2.png",
+                 },
+                 FRAME_DURATION * PLAYER_SPEED_SPRINT_MUL,
+                 {0, 1, 2, 1, 0, 3, 4, 3}},
+
+                {"dead",
+                 {
+                     "boss_death1_1.png",
+                     "boss_death1_2.png",
+                     "boss_death1_3.png",
+                     "boss_death1_4.png",
+                     "boss_death1_5.png",
+                     "boss_death1_6.png",
+                 },
+                     FRAME_DURATION}};
+    }
+
+    static EnemyPrefab MakePrefab(SDL_Renderer *renderer, bool isBoss)
+    {
+        EnemyPrefab prefab;
+        prefab.boss = isBoss;
+        prefab.maxHP = isBoss ? BOSS_MAX_HP : ENEMY_MAX_HP;
+        prefab.attackSpeed = isBoss ? BOSS_ATTACK_SPEED : ENEMY_ATTACK_SPEED;
+        prefab.animations = AnimationLibrary::Instance().Load(renderer, SpriteFolder(isBoss), Animations(isBoss));
+
+        // indices résolus une fois, Update ne compare plus de chaînes
+        prefab.idleClip = prefab.animations->IndexOf("idle");
+        prefab.walkClip = prefab.animations->IndexOf("walk");
+        prefab.attackClip = prefab.animations->IndexOf("attack");
+        prefab.chaseClip = prefab.animations->IndexOf("chase");
+        prefab.deadClip = prefab.animations->IndexOf("dead");
+        return prefab;
+    }
+
     void InitEnemy(SDL_Renderer *renderer, std::vector<Vector2D> idlepoints, bool isBoss = false)
     {
-        is_boss = isBoss;
-        SetMaxHP(isBoss ? BOSS_MAX_HP : ENEMY_MAX_HP);
+        InitFromPrefab(renderer, MakePrefab(renderer, isBoss), std::move(idlepoints));
+    }
+
+    void InitFromPrefab(SDL_Renderer *renderer, const EnemyPrefab &prefab, std::vector<Vector2D> idlepoints)
+    {
+        is_boss = prefab.boss;
+        SetMaxHP(prefab.maxHP);
 
-        idle_points = idlepoints;
+        idle_points = std::move(idlepoints);
         idle_points.push_back(GetWorldPosition()); // assurer qu'il y a toujours au moins un point
 
         InnerInit(renderer, 0.75f);
 
-        if (!is_boss)
-        {
-            animationSystem = std::make_unique<AnimationSystem>(renderer, "ENEMY1/");
-            animationSystem->SetEntries({{"idle",
-                                          {"enemy1_idle.png"},
-                                          FRAME_DURATION},
-
-                                         {"walk",
-                                          {
-                                              "enemy1_idle.png",
-                                              "enemy1_idle_step_left_1.png",
-                                              "enemy1_idle_step_left_2.png",
-                                              "enemy1_idle_step_right_1.png",
-                                              "enemy1_idle_step_right_2.png",
-                                          },
-                                          FRAME_DURATION,
-                                          {0, 1, 2, 1, 0, 3, 4, 3}},
-
-                                         {"attack",
-                                          {"enemy1_attack_0.png",
-                                           "enemy1_attack_1.png",
-                                           "enemy1_attack_2.png",
-                                           "enemy1_after_attack_0.png",
-                                           "enemy1_after_attack_1.png",
-                                           "enemy1_after_attack_2.png"},
-                                          ATTACK_FRAME_DURATION},
-
-                                         {"chase",
-                                          {
-                                              "enemy1_ready.png",
-                                              "enemy1_step_left_1.png",
-                                              "enemy1_step_left_2.png",
-                                              "enemy1_step_right_1.png",
-                                              "enemy1_step_right_2.png",
-                                          },
-                                          FRAME_DURATION * PLAYER_SPEED_SPRINT_MUL,
-                                          {0, 1, 2, 1, 0, 3, 4, 3}},
-
-                                         {"dead",
-                                          {
-                                              "enemy1_death1_1.png",
-                                              "enemy1_death1_2.png",
-                                              "enemy1_death1_3.png",
-                                              "enemy1_death1_4.png",
-                                              "enemy1_death1_5.png",
-                                              "enemy1_death1_6.png",
-                                          },
-                                          FRAME_DURATION}});
-        }
-        else
-        {
-            animationSystem = std::make_unique<AnimationSystem>(renderer, "BOSS/");
-            animationSystem->SetEntries({{"idle",
-                                          {"boss_idle.png"},
-                                          FRAME_DURATION},
-
-                                         {"walk",
-                                          {
-                                              "boss_idle.png",
-                                              "boss_step_left_1.png",
-                                              "boss_step_left_2.png",
-                                              "boss_step_right_1.png",
-                                              "boss_step_right_2.png",
-                                          },
-                                          FRAME_DURATION,
-                                          {0, 1, 2, 1, 0, 3, 4, 3}},
-
-                                         {"attack",
-                                          {"boss_attack_0.png",
-                                           "boss_attack_1.png",
-                                           "boss_attack_2.png",
-                                           "boss_after_attack_0.png",
-                                           "boss_after_attack_1.png",
-                                           "boss_after_attack_2.png"},
-                                          ATTACK_FRAME_DURATION},
-
-                                         {"chase",
-                                          {
-                                              "boss_idle.png",
-                                              "boss_step_left_1.png",
-                                              "boss_step_left_2.png",
-                                              "boss_step_right_1.png",
-                                              "boss_step_right_2.png",
-                                          },
-                                          FRAME_DURATION * PLAYER_SPEED_SPRINT_MUL,
-                                          {0, 1, 2, 1, 0, 3, 4, 3}},
-
-                                         {"dead",
-                                          {
-                                              "boss_death1_1.png",
-                                              "boss_death1_2.png",
-                                              "boss_death1_3.png",
-                                              "boss_death1_4.png",
-                                              "boss_death1_5.png",
-                                              "boss_death1_6.png",
-                                          },
-                                          FRAME_DURATION}});
-        }
+        SetAnimations(prefab.animations);
+        idleClip = prefab.idleClip;
+        walkClip = prefab.walkClip;
+        attackClip = prefab.attackClip;
+        chaseClip = prefab.chaseClip;
+        deadClip = prefab.deadClip;
 
-        attackSpeed = is_boss ? BOSS_ATTACK_SPEED : ENEMY_ATTACK_SPEED;
+        Attack().speed = prefab.attackSpeed;
 
         trigger = Scene::Instance().CreateObject<TriggerEnemy>();
         trigger->Init(renderer, this);
@@ -152,17 +200,18 @@ public:
     {
         player_ = p;
     }
-    void SetGrid(const Grid *grid)
+    void SetNavigation(const Astar::NavGrid *nav)
     {
-        grid_ = grid;
+        nav_ = nav;
     }
+
     void Update(float dt) override
     {
         trigger->SetActive(!IsDead() && is_chasing);
 
-        if (isDead)
+        if (IsDead())
         {
-            animationSystem->SetAnimation("dead", false);
+            Animation().Play(deadClip, false);
             return;
         }
 
@@ -175,7 +224,7 @@ public:
         Vector2D me_to_player_v = (myPos - playerPos);
         float range_to_player = me_to_player_v.sqr_norm();
 
-        if (grid_)
+        if (nav_)
         {
             if (computingPath_)
             {
@@ -188,20 +237,15 @@ public:
             }
             else
             {
+                if (pathVersion_ != nav_->Version())
+                    ValidatePath();
 
                 if (pathIndex_ >= path_.size() || can_chase_player && !target_was_player)
                 {
-                    Vector2D target_pos;
-                    if (can_chase_player && !target_was_player)
-                    {
-                        target_pos = playerPos;
+                    // recherche refusée (budget de la frame, hors de la grille) : nouvel essai à la prochaine mise à jour
+                    Vector2D target_pos = can_chase_player ? playerPos : Random::Choose(idle_points);
+                    if (requestPathTo(target_pos) && can_chase_player)
                         target_was_player = true;
-                    }
-                    else
-                    {
-                        target_pos = can_chase_player ? playerPos : Random::Choose(idle_points);
-                    }
-                    requestPathTo(target_pos);
                 }
                 else
                 {
@@ -259,15 +303,11 @@ public:
 
         // attack
 
-        if (attacking)
-        {
-            attackRemaining -= dt;
-        }
-        else
+        if (!attacking)
         {
             if (can_attack)
             {
-                attackRemaining = attackSpeed;
+                Attack().remaining = Attack().speed;
                 SoundManager::Instance().PlaySound("swing_sword");
 
                 auto raycast = Collision::Raycast(
@@ -282,7 +322,7 @@ public:
 
                 for (auto object : raycast)
                 {
-                    if (Entity *enemy = dynamic_cast<Entity *>(object))
+                    if (Entity *enemy = object->As<Entity>())
                     {
                         if (!enemy->IsDead())
                         {
@@ -302,21 +342,21 @@ public:
         // contrôler les animations
         if (attacking && can_chase_player)
         {
-            animationSystem->SetAnimation("attack", false);
+            Animation().Play(attackClip, false);
         }
         else
         {
             if (velocity.zero())
             {
-                animationSystem->SetAnimation("idle", false);
+                Animation().Play(idleClip, false);
             }
             else if (is_chasing)
             {
-                animationSystem->SetAnimation("chase", true);
+                Animation().Play(chaseClip, true);
             }
             else
             {
-                animationSystem->SetAnimation("walk", true);
+                Animation().Play(walkClip, true);
             }
         }
     }
@@ -326,43 +366,16 @@ public:
     {
         if (debug_show_)
         {
-            SDL_SetRenderDrawColor(renderer,
-                                   color_.r, color_.g,
-                                   color_.b, color_.a);
-            SDL_Rect r;
+            SDL_FRect r;
             r.x = int(givenPosition.x - renderDelimiter.x);
             r.y = int(givenPosition.y - renderDelimiter.y);
             r.w = int(renderDelimiter.x * 2.f);
             r.h = int(renderDelimiter.y * 2.f);
-            SDL_RenderFillRect(renderer, &r);
+            SpriteBatch::Instance().FillRect(renderer, r, color_);
         }
         else
         {
-            if (animationSystem == nullptr)
-                Debug::Log("null");
-            SDL_Texture *tex = animationSystem->Next(Time::DeltaTime());
-
-            int texW, texH;
-            SDL_QueryTexture(tex, nullptr, nullptr, &texW, &texH);
-
-            int dstW = static_cast<int>(texW * TEXTURE_SCALE);
-            int dstH = static_cast<int>(texH * TEXTURE_SCALE);
-
-            SDL_Rect dst;
-            dst.w = dstW;
-            dst.h = dstH;
-            dst.x = static_cast<int>(givenPosition.x - dstW / 2.0f);
-            dst.y = static_cast<int>(givenPosition.y - dstH / 2.0f);
-
-            SDL_Point center{dstW / 2, dstH / 2};
-
-            SDL_RenderCopyEx(renderer,
-                             tex,
-                             nullptr,
-                             &dst,
-                             GetRotation() + 90,
-                             &center,
-                             SDL_FLIP_NONE);
+            RenderSprite(renderer, givenPosition);
         }
     }
 
@@ -403,32 +416,76 @@ public:
     }
 
 private:
-    void requestPathTo(const Vector2D &goalWorld)
+    // indices de la case contenant le point dans la fenêtre de l'instantané, ramenés au bord ; faux hors de la fenêtre
+    static bool worldToGrid(const Vector2D &w, const Astar::NavSnapshot &nav, Vector2D &cell)
+    {
+        int H = (int)nav.grid.size();
+        int W = H ? (int)nav.grid[0].size() : 0;
+        int ix = (int)std::floor(w.x / LEVEL_SIZE_FACTOR) - nav.originX;
+        int iy = (int)std::floor(w.y / LEVEL_SIZE_FACTOR) - nav.originY;
+        cell = {float(std::clamp(ix, 0, std::max(W - 1, 0))), float(std::clamp(iy, 0, std::max(H - 1, 0)))};
+        return ix >= 0 && iy >= 0 && ix < W && iy < H;
+    }
+
+    // centre de la case
+    static Vector2D gridToWorld(const Vector2D &g, const Astar::NavSnapshot &nav)
     {
-        constexpr int GRID_SIZE = 100;
-        constexpr float HALF_CELLS = (GRID_SIZE - 1) / 2.0f;
+        return {(g.x + nav.originX + 0.5f) * LEVEL_SIZE_FACTOR, (g.y + nav.originY + 0.5f) * LEVEL_SIZE_FACTOR};
+    }
 
-        extern const float LEVEL_SIZE_FACTOR;
+    /**
+     * La grille a changé depuis le calcul du chemin (obstacle posé, déplacé ou retiré) : seuls les segments restants
+     * qui touchent les cases modifiées sont retestés, tous si plusieurs versions ont passé. Un segment bloqué
+     * abandonne le chemin, recalculé à la frame suivante. Un point sorti de la fenêtre de la grille (monde en morceaux)
+     * compte comme bloqué.
+     */
+    void ValidatePath()
+    {
+        Astar::NavHandle snapshot = nav_->Snapshot();
+        bool singleStep = snapshot->version == pathVersion_ + 1;
+        pathVersion_ = snapshot->version;
 
-        auto worldToGrid = [&](const Vector2D &w)
+        Vector2D from;
+        bool inside = worldToGrid(GetWorldPosition(), *snapshot, from);
+        for (size_t i = pathIndex_; i < path_.size() && inside; ++i)
         {
-            float gx = w.x / LEVEL_SIZE_FACTOR + HALF_CELLS;
-            float gy = w.y / LEVEL_SIZE_FACTOR + HALF_CELLS;
-            int ix = std::clamp(int(gx), 0, GRID_SIZE - 1);
-            int iy = std::clamp(int(gy), 0, GRID_SIZE - 1);
-            return Vector2D{float(ix), float(iy)};
-        };
-
-        Vector2D startWorld = GetWorldPosition();
-        Vector2D endWorld = goalWorld;
-        Vector2D startGrid = worldToGrid(startWorld);
-        Vector2D goalGrid = worldToGrid(endWorld);
+            Vector2D to;
+            inside = worldToGrid(path_[i], *snapshot, to);
+            SDL_Rect segment{(int)std::min(from.x, to.x), (int)std::min(from.y, to.y),
+                             (int)std::abs(to.x - from.x) + 1, (int)std::abs(to.y - from.y) + 1};
+            bool touched = !singleStep || SDL_HasIntersection(&segment, &snapshot->dirty);
+            if (!inside || (touched && raycastHitsWall(from, to, snapshot->grid)))
+            {
+                path_.clear();
+                pathIndex_ = 0;
+                return;
+            }
+            from = to;
+        }
+    }
+
+    bool requestPathTo(const Vector2D &goalWorld)
+    {
+        // la recherche garde son instantané de la grille, même si un obstacle bouge pendant le calcul
+        Astar::NavHandle snapshot = nav_->Snapshot();
+        pathVersion_ = snapshot->version;
+
+        // hors des morceaux chargés : l'ennemi attend que la grille l'atteigne
+        Vector2D startGrid, goalGrid;
+        if (!worldToGrid(GetWorldPosition(), *snapshot, startGrid))
+            return false;
+        worldToGrid(goalWorld, *snapshot, goalGrid);
+
+        // nombre de recherches lancées par frame limité sous charge
+        if (!QualityGovernor::Instance().AllowPathRequest())
+            return false;
 
         computingPath_ = true;
         pathFuture_ = std::async(
             std::launch::async,
-            [this, startGrid, goalGrid, &grid = *grid_]()
+            [startGrid, goalGrid, snapshot]()
             {
+                const Grid &grid = snapshot->grid;
                 auto pullString = [&](const std::vector<Vector2D> &in)
                 {
                     size_t n = in.size();
@@ -446,7 +503,7 @@ private:
                         size_t best = i + 1;
                         for (size_t j = n - 1; j > i + 1; --j)
                         {
-                            if (!raycastHitsWall(in[i], in[j], *grid_))
+                            if (!raycastHitsWall(in[i], in[j], grid))
                             {
                                 best = j;
                                 break;
@@ -458,30 +515,28 @@ private:
                     return out;
                 };
 
-                auto gridToWorld = [&](const Vector2D &g)
-                {
-                    float wx = (g.x - HALF_CELLS + 0.5f) * LEVEL_SIZE_FACTOR;
-                    float wy = (g.y - HALF_CELLS + 0.5f) * LEVEL_SIZE_FACTOR;
-                    return Vector2D{wx, wy};
-                };
-
-                auto raw = Astar::AStar(grid, startGrid, goalGrid);
+                // loin des murs si possible, sinon par n'importe quel passage
+                auto raw = Astar::AStar(grid, startGrid, goalGrid, &snapshot->clearance, ENEMY_PATH_CLEARANCE);
+                if (raw.size() < 2)
+                    raw = Astar::AStar(grid, startGrid, goalGrid);
                 auto clean = pullString(raw);
                 std::vector<Vector2D> worldPath;
                 worldPath.reserve(clean.size());
                 for (auto &c : clean)
                 {
-                    worldPath.push_back(gridToWorld(c));
+                    worldPath.push_back(gridToWorld(c, *snapshot));
                 }
                 return worldPath;
             });
+        return true;
     }
 
     bool is_chasing = false, target_was_player = false;
 
     std::shared_ptr<Entity> player_;
     std::shared_ptr<TriggerEnemy> trigger;
-    const Astar::Grid *grid_ = nullptr;
+    const Astar::NavGrid *nav_ = nullptr;
+    uint32_t pathVersion_ = 0; // version de la grille sur laquelle path_ a été calculé ou vérifié
 
     float speed_ = ENEMY_SPEED_IDLE;
     std::vector<Vector2D> path_;
@@ -495,4 +550,6 @@ private:
     SDL_Color color_{255, 0, 0, 255};
     bool debug_show_ = false;
     bool is_boss = false;
+
+    int idleClip = -1, walkClip = -1, attackClip = -1, chaseClip = -1, deadClip = -1;
 };
@@ -6,10 +6,26 @@
 #include <string>
 #include <algorithm>
 #include <utilities_animations.h>
+#include <components.h>
 
-class Entity : public Object
+class Entity : public TypedObject<Entity, Object>
 {
 public:
+    static constexpr uint32_t TYPE = Type_Entity;
+
+    Entity()
+    {
+        health = ComponentPool<HealthComponent>::Instance().Create(this);
+        attack = ComponentPool<AttackComponent>::Instance().Create(this);
+    }
+
+    ~Entity()
+    {
+        ComponentPool<HealthComponent>::Instance().Destroy(health);
+        ComponentPool<AttackComponent>::Instance().Destroy(attack);
+        ComponentPool<AnimationPlayer>::Instance().Destroy(animation);
+    }
+
     void InnerInit(SDL_Renderer *renderer, float shadowSize = 1.0f)
     {
         auto shadow = Scene::Instance().CreateObject<ShadowPlayer>();
@@ -21,35 +37,36 @@ public:
         hp_slide->SetColors({123, 240, 91, 255}, {50, 50, 50, 255});
         hp_slide->SetSize(65, 8);
         hp_slide->SetLayerOrder(800);
-        SetHP(maxHP);
+        SetHP(Health().maxHP);
 
     }
 
     void Damage(float amount)
     {
-        SetHP(currentHP - amount);
+        SetHP(Health().currentHP - amount);
     }
 
     void SetHP(float hp)
     {
-        currentHP = Math::Clamp(hp, 0.0f, maxHP);
+        HealthComponent &h = Health();
+        h.currentHP = Math::Clamp(hp, 0.0f, h.maxHP);
 
-        if (currentHP > 0.0f)
+        if (h.currentHP > 0.0f)
         {
-            isDead = false;
+            h.isDead = false;
+            RemoveFlag(Flag_Dead);
             hp_slide->SetActive(true);
-            hp_slide->SetValue(currentHP/maxHP);
+            hp_slide->SetValue(h.currentHP/h.maxHP);
         }
         else
         {
             hp_slide->SetActive(false);
-            isDead = true;
+            h.isDead = true;
             AddFlags(Flag_Dead);
 
             SoundManager::Instance().PlaySound("death");
 
             SetLayerOrder(0);
-            Scene::Instance().UpdateLayerOrder();
 
             OnDeath();
         }
@@ -57,32 +74,83 @@ public:
 
     virtual void OnDeath() { }
 
-    bool IsDead() const 
+    SDL_Texture *GetRenderTexture() const override
     {
-        return isDead;
+        auto &pool = ComponentPool<AnimationPlayer>::Instance();
+        return pool.Valid(animation) ? pool.Get(animation).Current() : nullptr;
+    }
+
+    bool IsDead() const
+    {
+        return ComponentPool<HealthComponent>::Instance().Get(health).isDead;
     }
 
     bool IsAttacking() const
     {
-        return attackRemaining > 0.0f;
+        return ComponentPool<AttackComponent>::Instance().Get(attack).attacking;
     }
 
     void SetMaxHP(float newMaxHP)
     {
-        maxHP = newMaxHP;
+        Health().maxHP = newMaxHP;
+    }
+
+    HealthComponent &Health()
+    {
+        return ComponentPool<HealthComponent>::Instance().Get(health);
+    }
+
+    AttackComponent &Attack()
+    {
+        return ComponentPool<AttackComponent>::Instance().Get(attack);
+    }
+
+    AnimationPlayer &Animation()
+    {
+        return ComponentPool<AnimationPlayer>::Instance().Get(animation);
     }
 
 protected:
-    float maxHP       = 100.0f;
-    float currentHP   = maxHP;
-    bool  isDead      = false;
+    // affiche la frame courante, tournée selon l'entité ; la taille vient de la région d'atlas
+    void RenderSprite(SDL_Renderer *renderer, const Vector2D &givenPosition)
+    {
+        if (!ComponentPool<AnimationPlayer>::Instance().Valid(animation))
+            return;
+        const SpriteFrame *frame = Animation().CurrentFrame();
+        if (!frame || !frame->texture)
+            return;
+
+        int dstW = static_cast<int>(frame->src.w * TEXTURE_SCALE);
+        int dstH = static_cast<int>(frame->src.h * TEXTURE_SCALE);
+
+        SDL_FRect dst;
+        dst.w = dstW;
+        dst.h = dstH;
+        dst.x = static_cast<int>(givenPosition.x - dstW / 2.0f);
+        dst.y = static_cast<int>(givenPosition.y - dstH / 2.0f);
+
+        SpriteBatch::Instance().Draw(renderer, *frame, dst, GetRotation() + 90);
+    }
 
-    std::unique_ptr<AnimationSystem> animationSystem;
-    std::shared_ptr<SlideValue> hp_slide;
+    // les clips sont partagés, seul le lecteur est propre à l'entité
+    void SetAnimations(std::shared_ptr<const AnimationSet> set)
+    {
+        ComponentPool<AnimationPlayer>::Instance().Destroy(animation);
+        AnimationPlayer player;
+        player.set = std::move(set);
+        animation = ComponentPool<AnimationPlayer>::Instance().Create(this, std::move(player));
+    }
 
-    float attackSpeed     = 0.35f;
-    float attackRemaining = 0.0f;
-    float attackCast      = 0.5f;
+    int ClipIndex(const std::string &id)
+    {
+        return Animation().set->IndexOf(id);
+    }
+
+    ComponentPool<HealthComponent>::Handle health;
+    ComponentPool<AttackComponent>::Handle attack;
+    ComponentPool<AnimationPlayer>::Handle animation = ComponentPool<AnimationPlayer>::INVALID_HANDLE;
+
+    std::shared_ptr<SlideValue> hp_slide;
 
     Vector2D velocity{0,0};
     bool     walking{false};
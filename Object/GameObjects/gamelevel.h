@@ -6,6 +6,7 @@
 #include <vector>
 #include <scene.h>
 #include <utilities_animations.h>
+#include <components.h>
 
 using Grid = std::vector<std::vector<bool>>;
 
@@ -16,10 +17,17 @@ public:
     {
     }
 
+    ~GameLevel()
+    {
+        ComponentPool<AnimationPlayer>::Instance().Destroy(background);
+        ComponentPool<AnimationPlayer>::Instance().Destroy(foreground);
+    }
+
     bool Init(SDL_Renderer *renderer,
               Scene *_mainScene,
               float sizeFactor,
               Vector2D spawn,
+              Vector2D exit,
               std::string mainPath,
               const std::vector<std::string> &backgroundSpritePaths,
               const std::vector<std::string> &foregroundSpritePaths,
@@ -32,6 +40,7 @@ public:
         collision = false;
         mainScene = _mainScene;
         playerSpawn = spawn;
+        exitPoint = exit;
 
         InitAnimations(renderer, mainPath, backgroundSpritePaths, foregroundSpritePaths);
 
@@ -40,24 +49,16 @@ public:
         return true;
     }
 
+    /**
+     * Fond et premier plan ont chacun leur lecteur dans le ComponentPool : ils avancent avec les entités
+     * dans Animations::UpdatePlayers (pas quand le niveau est inactif, moins souvent sous charge), le rendu lit la frame courante.
+     */
     void InitAnimations(SDL_Renderer *renderer, std::string mainPath,
                         const std::vector<std::string> &backgroundSpritePaths,
                         const std::vector<std::string> &foregroundSpritePaths)
     {
-        if (backgroundSpritePaths.size() != 0)
-        {
-            backgroundSystem = std::make_unique<AnimationSystem>(renderer, mainPath);
-            backgroundSystem->SetEntries({{"main", backgroundSpritePaths, FRAME_DURATION}});
-
-            backgroundSystem->SetAnimation("main");
-        }
-        if (foregroundSpritePaths.size() != 0)
-        {
-            foregroundSystem = std::make_unique<AnimationSystem>(renderer, mainPath);
-            foregroundSystem->SetEntries({{"main", foregroundSpritePaths, FRAME_DURATION}});
-
-            foregroundSystem->SetAnimation("main");
-        }
+        background = CreateLayerPlayer(renderer, mainPath, backgroundSpritePaths, background);
+        foreground = CreateLayerPlayer(renderer, mainPath, foregroundSpritePaths, foreground);
     }
 
     void SetEnemies(std::vector<std::shared_ptr<Object>> entities)
@@ -66,7 +67,7 @@ public:
         for (auto enemy: enemies)
         {
             enemy->SetParent(this);
-            enemy->SetLayerOrder(901);
+            enemy->SetLayerOrder(ENTITY_LAYER);
         }
     }
 
@@ -80,26 +81,73 @@ public:
         return playerSpawn;
     }
 
+    Vector2D ExitPoint()
+    {
+        return exitPoint;
+    }
+
+    /**
+     * Version précompilée (même chemin en .lvl, voir level_compiler.py) si elle existe :
+     * rectangles, grille, dégagement et points viennent du fichier. Sinon le JSON est lu, ses rectangles regroupés
+     * et la grille calculée. Avec LEVEL_TILE_COLLISION, aucun Wall n'est créé : le décor est testé sur la grille.
+     */
     void InitRects(const std::string &rectsPath)
     {
-        if (rectsPath.size() == 0) return;
+        hitboxPath = rectsPath;
+        LoadGeometry(true, true);
+    }
 
-        auto rects = LoadRects(rectsPath);
-        sdlrects.reserve(rects.size());
-        for (CoupleRect crect : rects)
+    /**
+     * Rechargement à chaud : si path est la hitbox du niveau (JSON ou .lvl), murs, grille et dégagement sont reconstruits ;
+     * les obstacles posés en jeu restent, et les ennemis vérifient leur chemin sur la nouvelle version de la grille.
+     * Un JSON modifié est relu directement puisque le .lvl voisin est périmé. Apparition et sortie ne bougent pas.
+     * Un fichier illisible (sauvegarde en cours d'édition) laisse l'ancien décor en place.
+     */
+    bool ReloadGeometry(const std::string &path)
+    {
+        if (hitboxPath.empty())
+            return false;
+        bool compiled = path == CompiledPath();
+        if (!compiled && path != hitboxPath)
+            return false;
+
+        if (!LoadGeometry(compiled, false))
         {
-            BoxRect brect = crect.brect;
-            SDL_Rect sdlrect = crect.sdlrect;
+            Debug::Error("GameLevel: " + path + " could not be read, previous geometry kept");
+            return false;
+        }
+        if (!compiled)
+            Debug::Log("GameLevel: " + hitboxPath + " reloaded from JSON, run level_compiler.py to update the .lvl");
+        return true;
+    }
 
-            auto rect_object = mainScene->CreateObject<Wall>();
-            rect_object->Init(brect.w * size, brect.h * size);
-            rect_object->SetPosition(brect.x * size, brect.y * size);
-            rect_object->SetParent(this);
+    /**
+     * Monde en morceaux (voir ChunkStreamer) : fonds et grille viennent des morceaux gardés autour de la caméra,
+     * ceux autour de l'apparition sont lus tout de suite. À appeler avant de poser les obstacles et les ennemis.
+     */
+    void InitChunks(const ChunkSettings &settings)
+    {
+        chunks = std::make_shared<ChunkStreamer>();
+        chunks->Init(settings, size, &nav);
 
-            sdlrects.push_back(sdlrect);
-        }
+        // le niveau n'est plus une salle de 100 cases : il reste affiché tant qu'un morceau peut l'être
+        float span = settings.cells * size;
+        renderDelimiter.x = std::max(std::abs(settings.minX), std::abs(settings.maxX + 1)) * span;
+        renderDelimiter.y = std::max(std::abs(settings.minY), std::abs(settings.maxY + 1)) * span;
+
+        chunks->LoadAround(playerSpawn);
+    }
+
+    bool IsChunked() const
+    {
+        return chunks != nullptr;
+    }
 
-        grid = BuildGrid();
+    // une fois par frame, avant de lire la grille pour les collisions ; focus en coordonnées du monde
+    void StreamChunks(const Vector2D &focus)
+    {
+        if (chunks)
+            chunks->Update(focus - GetWorldPosition());
     }
 
     void SetOffset(const Vector2D &o)
@@ -109,50 +157,38 @@ public:
 
     void Render(SDL_Renderer *renderer, const Vector2D &givenPosition) override
     {
-        if (backgroundSystem == nullptr) return;
-        SDL_Texture *tex = backgroundSystem->Next(Time::DeltaTime());
+        lastGivenPos = givenPosition;
+        const SpriteFrame *frame = LayerFrame(background);
+        if (!frame && !chunks)
+            return;
 
-        if (tex)
+        auto draw = [&](const Vector2D &origin)
         {
-            int texW, texH;
-            SDL_QueryTexture(tex, nullptr, nullptr, &texW, &texH);
-
-            int dstW = static_cast<int>(texW * size);
-            int dstH = static_cast<int>(texH * size);
-
-            SDL_FRect dst;
-            dst.w = dstW;
-            dst.h = dstH;
-            dst.x = givenPosition.x - dstW / 2.0f;
-            dst.y = givenPosition.y - dstH / 2.0f;
-
-            SDL_RenderCopyF(renderer, tex, nullptr, &dst);
-        }
-
-        lastGivenPos = givenPosition;
+            if (chunks)
+                chunks->Render(renderer, origin, mainScene->GetCamera()->GetViewportSize());
+            if (frame)
+                DrawLayer(renderer, *frame, backgroundTiles, origin);
+        };
+        if (STATIC_LAYER_CACHE)
+            LayerCaches()[0].Render(renderer, mainScene->GetCamera()->GetViewportSize(), givenPosition, LayerKey(frame), draw);
+        else
+            draw(givenPosition);
     }
 
     void PostRender(SDL_Renderer *renderer)
     {
-        if (foregroundSystem == nullptr) return;
-        SDL_Texture *tex = foregroundSystem->Next(Time::DeltaTime());
+        const SpriteFrame *frame = LayerFrame(foreground);
+        if (!frame)
+            return;
 
-        if (tex)
+        auto draw = [&](const Vector2D &origin)
         {
-            int texW, texH;
-            SDL_QueryTexture(tex, nullptr, nullptr, &texW, &texH);
-
-            int dstW = static_cast<int>(texW * size);
-            int dstH = static_cast<int>(texH * size);
-
-            SDL_FRect dst;
-            dst.w = dstW;
-            dst.h = dstH;
-            dst.x = lastGivenPos.x - dstW / 2.0f;
-            dst.y = lastGivenPos.y - dstH / 2.0f;
-
-            SDL_RenderCopyF(renderer, tex, nullptr, &dst);
-        }
+            DrawLayer(renderer, *frame, foregroundTiles, origin);
+        };
+        if (STATIC_LAYER_CACHE)
+            LayerCaches()[1].Render(renderer, mainScene->GetCamera()->GetViewportSize(), lastGivenPos, LayerKey(frame), draw);
+        else
+            draw(lastGivenPos);
     }
 
     void SetSize(float sizeFactor)
@@ -185,7 +221,28 @@ public:
 
     const Grid *GetGrid() const
     {
-        return &grid;
+        return &nav.Cells();
+    }
+
+    // grille modifiable en jeu (obstacles), lue par les ennemis au travers de ses instantanés
+    Astar::NavGrid &GetNavigation()
+    {
+        return nav;
+    }
+
+    // cases globales couvertes par un rectangle de w x h cases centré sur une position locale au niveau
+    SDL_Rect CellsAt(const Vector2D &center, int w, int h) const
+    {
+        int x0 = (int)std::lround(center.x / size - w * 0.5f);
+        int y0 = (int)std::lround(center.y / size - h * 0.5f);
+        return {x0, y0, w, h};
+    }
+
+    // grille du niveau placée dans le monde, pour la collision par cases
+    Collision::TileMap GetTileMap() const
+    {
+        Vector2D origin = {nav.OriginX() * size, nav.OriginY() * size};
+        return {&nav.Cells(), GetWorldPosition() + origin, size};
     }
 
     bool IsPlayerAllowed() const
@@ -199,14 +256,188 @@ public:
     }
 
 private:
-    std::unique_ptr<AnimationSystem> backgroundSystem, foregroundSystem;
-    Vector2D offset, playerSpawn;
+    /**
+     * Découpe d'une image de calque en carreaux : source dans la frame et destination par rapport au centre du niveau.
+     * Le côté est choisi à l'écran (LEVEL_LAYER_TILE_FRACTION du petit côté de la vue) puis ramené en pixels de la frame,
+     * pour que le test contre la vue écarte vraiment des carreaux quelle que soit l'échelle du niveau.
+     * Recalculée seulement si la taille de la frame, l'échelle ou la vue change,
+     * les frames d'une animation de même taille partagent donc le même découpage.
+     */
+    struct LayerTiles
+    {
+        struct Tile
+        {
+            SDL_Rect src;
+            SDL_FRect dst;
+        };
+        std::vector<Tile> tiles;
+        int width = 0, height = 0, side = 0;
+        float scale = 0.0f;
+
+        void Layout(int w, int h, float _scale, const Vector2D &viewport)
+        {
+            int _side = std::max(1, (int)(std::min(viewport.x, viewport.y) * LEVEL_LAYER_TILE_FRACTION / _scale));
+            if (w == width && h == height && _scale == scale && _side == side)
+                return;
+            width = w;
+            height = h;
+            scale = _scale;
+            side = _side;
+
+            tiles.clear();
+            for (int y = 0; y < h; y += side)
+                for (int x = 0; x < w; x += side)
+                {
+                    SDL_Rect src{x, y, std::min(side, w - x), std::min(side, h - y)};
+                    // bords partagés au pixel près entre carreaux voisins : pas de joint visible
+                    SDL_FRect dst{(x - w * 0.5f) * scale, (y - h * 0.5f) * scale, src.w * scale, src.h * scale};
+                    tiles.push_back({src, dst});
+                }
+        }
+    };
+
+    using LayerHandle = ComponentPool<AnimationPlayer>::Handle;
+
+    LayerHandle CreateLayerPlayer(SDL_Renderer *renderer, const std::string &mainPath,
+                                  const std::vector<std::string> &paths, LayerHandle previous)
+    {
+        auto &pool = ComponentPool<AnimationPlayer>::Instance();
+        pool.Destroy(previous);
+        if (paths.empty())
+            return ComponentPool<AnimationPlayer>::INVALID_HANDLE;
+
+        AnimationPlayer player;
+        player.set = std::make_shared<const AnimationSet>(renderer, mainPath, std::vector<AnimationEntryTmp>{{"main", paths, FRAME_DURATION}});
+        player.Play(0);
+        return pool.Create(this, std::move(player));
+    }
+
+    static const SpriteFrame *LayerFrame(LayerHandle handle)
+    {
+        auto &pool = ComponentPool<AnimationPlayer>::Instance();
+        return pool.Valid(handle) ? pool.Get(handle).CurrentFrame() : nullptr;
+    }
+
+    // fond et premier plan, partagés par tous les niveaux puisque seul le niveau courant est affiché
+    static LayerCache *LayerCaches()
+    {
+        static LayerCache caches[2];
+        return caches;
+    }
+
+    // contenu d'un calque : niveau, frame affichée et fonds des morceaux chargés
+    uint64_t LayerKey(const SpriteFrame *frame) const
+    {
+        uint64_t key = reinterpret_cast<uintptr_t>(this);
+        if (frame)
+        {
+            key = key * 31 + reinterpret_cast<uintptr_t>(frame->texture.get());
+            key = key * 31 + (uint32_t)frame->src.x;
+            key = key * 31 + (uint32_t)frame->src.y;
+        }
+        return key * 31 + (chunks ? chunks->Revision() : 0);
+    }
+
+    // calque centré sur center (position à l'écran), seuls les carreaux dans la vue sont envoyés au SpriteBatch
+    void DrawLayer(SDL_Renderer *renderer, const SpriteFrame &frame, LayerTiles &layer, const Vector2D &center)
+    {
+        if (!frame.texture)
+            return;
+        Vector2D viewport = mainScene->GetCamera()->GetViewportSize();
+        layer.Layout(frame.src.w, frame.src.h, size, viewport);
+
+        for (const LayerTiles::Tile &tile : layer.tiles)
+        {
+            SDL_FRect dst{center.x + tile.dst.x, center.y + tile.dst.y, tile.dst.w, tile.dst.h};
+            if (dst.x > viewport.x || dst.y > viewport.y || dst.x + dst.w < 0 || dst.y + dst.h < 0)
+                continue;
+            SDL_Rect src{frame.src.x + tile.src.x, frame.src.y + tile.src.y, tile.src.w, tile.src.h};
+            SpriteBatch::Instance().Draw(renderer, frame.texture->sdl, frame.texture->width, frame.texture->height, src, dst);
+        }
+    }
+
+    std::string CompiledPath() const
+    {
+        return hitboxPath.substr(0, hitboxPath.rfind('.')) + ".lvl";
+    }
+
+    // les rectangles sont lus entièrement avant de toucher au décor en place : faux, et rien ne change, si la lecture échoue
+    bool LoadGeometry(bool preferCompiled, bool readPoints)
+    {
+        if (hitboxPath.size() == 0) return false;
+
+        LevelFile file;
+        bool compiled = preferCompiled && file.Open(CompiledPath());
+        std::vector<CoupleRect> rects;
+        if (compiled)
+        {
+            rects.reserve(file.RectCount());
+            for (size_t i = 0; i < file.RectCount(); ++i)
+                rects.push_back(file.Rect(i));
+        }
+        else
+        {
+            if (!LoadRects(hitboxPath, rects))
+                return false;
+            rects = MergeRects(rects);
+        }
+
+        for (auto &wall : walls)
+            mainScene->DestroyObject(wall);
+        walls.clear();
+        sdlrects.clear();
+        sdlrects.reserve(rects.size());
+        for (const CoupleRect &crect : rects)
+            AddWall(crect);
+
+        if (compiled)
+        {
+            Grid grid = file.NavGrid();
+            int half = (int)grid.size() / 2; // salle centrée sur la position du niveau
+            nav.Reset(std::move(grid), file.Clearance(), -half, -half);
+            if (readPoints && file.HasPoints())
+            {
+                playerSpawn = file.Spawn();
+                exitPoint = file.Exit();
+            }
+            return true;
+        }
+
+        Grid grid = BuildGrid();
+        std::vector<uint8_t> clearance = Astar::BuildClearance(grid);
+        int half = (int)grid.size() / 2;
+        nav.Reset(std::move(grid), std::move(clearance), -half, -half);
+        return true;
+    }
+
+    void AddWall(const CoupleRect &crect)
+    {
+        sdlrects.push_back(crect.sdlrect);
+        if (LEVEL_TILE_COLLISION)
+            return;
+
+        const BoxRect &brect = crect.brect;
+
+        auto rect_object = mainScene->CreateObject<Wall>();
+        rect_object->Init(brect.w * size, brect.h * size);
+        rect_object->SetPosition(brect.x * size, brect.y * size);
+        rect_object->SetParent(this);
+        walls.push_back(rect_object);
+    }
+
+    LayerHandle background = ComponentPool<AnimationPlayer>::INVALID_HANDLE;
+    LayerHandle foreground = ComponentPool<AnimationPlayer>::INVALID_HANDLE;
+    LayerTiles backgroundTiles, foregroundTiles;
+    Vector2D offset, playerSpawn, exitPoint;
     Vector2D lastGivenPos;
     float size = 1.0f;
     Scene *mainScene;
     std::vector<SDL_Rect> sdlrects;
     std::vector<std::shared_ptr<Object>> enemies;
-    Grid grid;
+    std::vector<std::shared_ptr<Object>> walls; // vide avec LEVEL_TILE_COLLISION
+    std::string hitboxPath;
+    Astar::NavGrid nav;
+    std::shared_ptr<ChunkStreamer> chunks; // partagé avec les onReady des images en cours de chargement
 
     bool allow_player = true;
 };
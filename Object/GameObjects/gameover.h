@@ -12,36 +12,20 @@ public:
     {
         SetPosition(0.0f, 0.0f);
         SetRotation(.0f);
-    }
-
-    ~GameOver()
-    {
-        if (game_over_img)
-            SDL_DestroyTexture(game_over_img);
+        screenSpace = true;
     }
 
     void Init(SDL_Renderer *renderer)
     {
         collision = false;
 
-        SDL_Surface *surf = IMG_Load("Assets/game_over.png");
-        if (!surf)
-        {
-            SDL_Log("Failed to load shadow: %s", IMG_GetError());
-            return;
-        }
-
-        game_over_img = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
-
+        game_over_img = TextureCache::Instance().Load(renderer, "Assets/game_over.png");
         if (!game_over_img)
-        {
-            SDL_Log("Failed to create texture: %s", SDL_GetError());
             return;
-        }
 
         SetLayerOrder(11000);
-        SDL_SetTextureAlphaMod(game_over_img, alpha);
+        // l'opacité passe par la couleur des sommets, la texture doit être mélangée
+        SDL_SetTextureBlendMode(game_over_img->sdl, SDL_BLENDMODE_BLEND);
 
         SetGameOver(false);
     }
@@ -58,27 +42,29 @@ public:
         if (game_over_img && game_over && alpha < 250)
         {
             alpha = Math::Lerp(alpha, 255, deltaTime * 5.0f);
-
-            SDL_SetTextureAlphaMod(game_over_img, alpha);
         }
     }
 
     void Render(SDL_Renderer *renderer, const Vector2D &givenPosition) override
     {
+        if (!game_over_img)
+            return;
+
         int w, h;
         SDL_GetRendererOutputSize(renderer, &w, &h);
 
-        SDL_Rect rect;
+        SDL_FRect rect;
         rect.w = w;
         rect.h = h;
         rect.x = 0;
         rect.y = 0;
         
-        SDL_RenderCopy(renderer, game_over_img, nullptr, &rect);
+        SpriteBatch::Instance().Draw(renderer, game_over_img->sdl, game_over_img->width, game_over_img->height,
+                                     {0, 0, game_over_img->width, game_over_img->height}, rect, 0.0f, {255, 255, 255, alpha});
     }
 
 private:
 bool game_over;
 Uint8 alpha;
-    SDL_Texture *game_over_img;
+    TextureHandle game_over_img;
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <cmath>
+
+/**
+ * Écran de chargement : plein écran tant que le bundle bloquant n'est pas prêt ou qu'un niveau est attendu,
+ * simple barre en bas de l'écran pendant les chargements en arrière-plan.
+ */
+class LoadingScreen : public Object
+{
+public:
+    LoadingScreen()
+    {
+        SetPosition(0.0f, 0.0f);
+        screenSpace = true;
+        collision = false;
+        SetLayerOrder(12000);
+    }
+
+    void Init(const std::string &blockingBundle)
+    {
+        blocking = blockingBundle;
+        elapsed = 0.0f;
+    }
+
+    void Update(float deltaTime) override
+    {
+        elapsed += deltaTime;
+    }
+
+    void Render(SDL_Renderer *renderer, const Vector2D &givenPosition) override
+    {
+        AssetLoader &loader = AssetLoader::Instance();
+        bool waiting = !loader.IsReady(blocking) || Scene::Instance().IsLevelPending();
+        if (!waiting && loader.IsIdle())
+            return;
+        float progress = loader.Progress();
+
+        int w, h;
+        SDL_GetRendererOutputSize(renderer, &w, &h);
+        SpriteBatch &batch = SpriteBatch::Instance();
+
+        if (!waiting)
+        {
+            batch.FillRect(renderer, {0.0f, h - BAR_THIN, w * progress, BAR_THIN}, BAR_COLOR);
+            return;
+        }
+
+        batch.FillRect(renderer, {0.0f, 0.0f, static_cast<float>(w), static_cast<float>(h)}, {0, 0, 0, 255});
+
+        float barX = (w - BAR_WIDTH) * 0.5f, barY = h * 0.5f;
+        batch.FillRect(renderer, {barX, barY, BAR_WIDTH, BAR_HEIGHT}, {50, 50, 50, 255});
+        batch.FillRect(renderer, {barX, barY, BAR_WIDTH * progress, BAR_HEIGHT}, BAR_COLOR);
+
+        // trois carrés qui pulsent au-dessus de la barre : l'écran bouge même si la barre n'avance pas
+        for (int i = 0; i < 3; ++i)
+        {
+            // fond noir : assombrir la couleur revient à la rendre transparente
+            float pulse = 0.25f + 0.75f * (0.5f + 0.5f * std::sin(elapsed * 6.0f - i * 0.8f));
+            SDL_Color color = {static_cast<Uint8>(BAR_COLOR.r * pulse), static_cast<Uint8>(BAR_COLOR.g * pulse),
+                               static_cast<Uint8>(BAR_COLOR.b * pulse), 255};
+            float x = w * 0.5f + (i - 1) * 24.0f - 6.0f;
+            batch.FillRect(renderer, {x, barY - 40.0f, 12.0f, 12.0f}, color);
+        }
+    }
+
+private:
+    static constexpr float BAR_WIDTH = 400.0f;
+    static constexpr float BAR_HEIGHT = 8.0f;
+    static constexpr float BAR_THIN = 4.0f;
+    static constexpr SDL_Color BAR_COLOR = {230, 225, 94, 255};
+
+    std::string blocking;
+    float elapsed = 0.0f;
+};
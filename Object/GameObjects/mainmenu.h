@@ -11,13 +11,14 @@ public:
 MainMenu()
     {
         SetPosition(0.0f, 0.0f);
+        screenSpace = true;
         delimiterAffectedByRotation = false;
         collision = false;
     }
 
     void Init(SDL_Renderer* renderer)
     {
-        mainMenuAnimationSystem = std::make_unique<AnimationSystem>(renderer, "MainMenu/");
+        mainMenuAnimationSystem = std::make_unique<VideoStream>(renderer, "MainMenu/");
         
         size_t frame_count_1 = 42, frame_count_2 = 22;
         std::vector<std::string> paths1;
@@ -39,18 +40,18 @@ MainMenu()
             else number = std::string("0") + std::to_string(i);
             paths2.push_back("loop/menu_loop_" + number + ".png");
         }
-        mainMenuAnimationSystem->SetEntries({  { "start", paths1, 0.075f },   { "loop", paths2, 0.075f } });
-        mainMenuAnimationSystem->SetAnimation("start", false);
+        mainMenuAnimationSystem->SetClips({  { "start", paths1, 0.075f },   { "loop", paths2, 0.075f } });
+        mainMenuAnimationSystem->Play("start", false);
     }
 
     void Update(float deltaTime) override
     {
         if (mainMenuAnimationSystem !=nullptr && mainMenuAnimationSystem->CurrentId()=="start"&&mainMenuAnimationSystem->Finished())
         {
-            mainMenuAnimationSystem->SetAnimation("loop", true);
+            mainMenuAnimationSystem->Play("loop", true);
         }
 
-        if (Input::GetKeyDown(SDL_SCANCODE_SPACE))
+        if (Input::GetKeyDown(SDL_SCANCODE_SPACE) && !Scene::Instance().IsLevelPending())
         {
             SoundManager::Instance().StopAll();
             SoundManager::Instance().PlaySound("dojo_ost", true, 0.5f);
@@ -70,20 +71,21 @@ MainMenu()
     {
         if (!debug_show || mainMenuAnimationSystem == nullptr) return;
 
-        SDL_Texture* tex = mainMenuAnimationSystem->Next(Time::DeltaTime());
+        const SpriteFrame* frame = mainMenuAnimationSystem->NextFrame(Time::DeltaTime());
+        if (!frame) return;
 
         int w, h;
         SDL_GetRendererOutputSize(renderer, &w, &h);
 
-        SDL_Rect rect;
+        SDL_FRect rect;
         rect.w = w;
         rect.h = h;
         rect.x = 0;
         rect.y = 0;
-        SDL_RenderCopy(renderer, tex, nullptr, &rect);
+        SpriteBatch::Instance().Draw(renderer, *frame, rect);
     }
 
 private:
-    std::unique_ptr<AnimationSystem> mainMenuAnimationSystem;
+    std::unique_ptr<VideoStream> mainMenuAnimationSystem;
     bool debug_show = true;
 };
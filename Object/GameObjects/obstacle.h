@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+
+/**
+ * Obstacle posé en jeu sur la grille d'un niveau (caisse, porte, éboulis) : ses cases bloquent la navigation des ennemis
+ * et, avec LEVEL_TILE_COLLISION, le joueur. Le déplacer ou le détruire ne met à jour que les cases touchées.
+ */
+class Obstacle : public Object
+{
+public:
+    Obstacle()
+    {
+        SetFlags(ObjectFlag::Flag_Wall);
+        delimiterAffectedByRotation = false;
+        // sans collision par cases, il arrête le joueur comme un Wall
+        collision = !LEVEL_TILE_COLLISION;
+    }
+
+    // à appeler après SetPosition (locale au niveau) ; taille en cases de la grille
+    void Init(SDL_Renderer *renderer, Scene::GameLevel *_level, int w, int h, const std::string &spritePath = "")
+    {
+        level = _level;
+        cellsW = w;
+        cellsH = h;
+        SetParent(level);
+
+        renderDelimiter.x = collisionDelimiter.x = w * LEVEL_SIZE_FACTOR * 0.5f;
+        renderDelimiter.y = collisionDelimiter.y = h * LEVEL_SIZE_FACTOR * 0.5f;
+
+        if (!spritePath.empty())
+            sprite = TextureCache::Instance().Load(renderer, spritePath);
+
+        cells = level->CellsAt(GetLocalPosition(), cellsW, cellsH);
+        level->GetNavigation().Block(cells);
+        blocking = true;
+    }
+
+    void MoveTo(const Vector2D &position)
+    {
+        SetPosition(position);
+        if (!blocking)
+            return;
+
+        SDL_Rect next = level->CellsAt(position, cellsW, cellsH);
+        if (SDL_RectEquals(&next, &cells))
+            return;
+        level->GetNavigation().Move(cells, next);
+        cells = next;
+    }
+
+    // ses cases sont libérées ; l'objet reste inactif jusqu'à ce que la scène le détruise
+    void Break()
+    {
+        Release();
+        SetActive(false);
+    }
+
+    bool IsBroken() const
+    {
+        return !blocking;
+    }
+
+    void OnDestroy() override
+    {
+        Release();
+    }
+
+    void Render(SDL_Renderer *renderer, const Vector2D &givenPosition) override
+    {
+        if (!sprite)
+            return;
+
+        SDL_FRect rect;
+        rect.w = renderDelimiter.x * 2.0f;
+        rect.h = renderDelimiter.y * 2.0f;
+        rect.x = givenPosition.x - renderDelimiter.x;
+        rect.y = givenPosition.y - renderDelimiter.y;
+        SpriteBatch::Instance().Draw(renderer, sprite->sdl, sprite->width, sprite->height, {0, 0, sprite->width, sprite->height}, rect);
+    }
+
+    SDL_Texture *GetRenderTexture() const override
+    {
+        return sprite ? sprite->sdl : nullptr;
+    }
+
+private:
+    void Release()
+    {
+        // le niveau peut être déchargé en même temps que l'obstacle
+        if (blocking && !level->IsDestroyed())
+            level->GetNavigation().Unblock(cells);
+        blocking = false;
+    }
+
+    Scene::GameLevel *level = nullptr;
+    TextureHandle sprite;
+    SDL_Rect cells{0, 0, 0, 0};
+    int cellsW = 0, cellsH = 0;
+    bool blocking = false;
+};
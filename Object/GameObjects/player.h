@@ -7,9 +7,11 @@
 #include <algorithm>
 #include <utilities_animations.h>
 
-class Player : public Entity
+class Player : public TypedObject<Player, Entity>
 {
 public:
+    static constexpr uint32_t TYPE = Type_Player;
+
     Player()
     {
         SetPosition(0.0f, 0.0f);
@@ -21,9 +23,8 @@ public:
         walking = false;
         frameTimer = 0.0f;
         collision = true;
-        isDead = false;
         autoLock = false;
-        attackSpeed = PLAYER_ATTACK_SPEED;
+        Attack().speed = PLAYER_ATTACK_SPEED;
         did_death_animation = false;
     }
 
@@ -31,6 +32,54 @@ public:
     {
     }
 
+    static constexpr const char *SPRITE_FOLDER = "MC/";
+
+    // clips du joueur, aussi utilisés pour précharger l'atlas (AnimationSet::AtlasPaths)
+    static std::vector<AnimationEntryTmp> Animations()
+    {
+        return {{"idle",
+                 {"mc_idle.png"},
+                 FRAME_DURATION},
+
+                {"walk",
+                 {"mc_idle.png",
+                  "mc_walk_left_1.png",
+                  "mc_walk_left_2.png",
+                  "mc_walk_right_1.png",
+                  "mc_walk_right_2.png"},
+                 FRAME_DURATION,
+                 {0, 1, 2, 1, 0, 3, 4, 3}},
+
+                {"attack",
+                 {"mc_after_attack_0.png",
+                  "mc_after_attack_1.png",
+                  "mc_after_attack_2.png",
+                  "mc_attack_1.png",
+                  "mc_attack_2.png",
+                  "mc_idle.png"},
+                 ATTACK_FRAME_DURATION,
+                 {2, 3, 4, 0, 1, 2, 5}},
+
+                {"sprint",
+                 {"mc_idle.png",
+                  "mc_walk_left_1.png",
+                  "mc_walk_left_2.png",
+                  "mc_walk_right_1.png",
+                  "mc_walk_right_2.png"},
+                 FRAME_DURATION * PLAYER_SPEED_SPRINT_MUL,
+                 {0, 1, 2, 1, 0, 3, 4, 3}},
+
+                {"dead",
+                 {"mc_death_1.png",
+                  "mc_death_2.png",
+                  "mc_death_3.png",
+                  "mc_death_4.png",
+                  "mc_death_5.png",
+                  "mc_death_6.png",
+                  "mc_death_7.png"},
+             FRAME_DURATION}};
+    }
+
     void InitPlayer(SDL_Renderer *renderer)
     {
         SetMaxHP(PLAYER_MAX_HP);
@@ -42,48 +91,14 @@ public:
         cinematic_system->SetActive(true);
         cinematic_system->SetLayerOrder(9999);
 
-        animationSystem = std::make_unique<AnimationSystem>(renderer, "MC/");
-        animationSystem->SetEntries({{"idle",
-                                      {"mc_idle.png"},
-                                      FRAME_DURATION},
-
-                                     {"walk",
-                                      {"mc_idle.png",
-                                       "mc_walk_left_1.png",
-                                       "mc_walk_left_2.png",
-                                       "mc_walk_right_1.png",
-                                       "mc_walk_right_2.png"},
-                                      FRAME_DURATION,
-                                      {0, 1, 2, 1, 0, 3, 4, 3}},
-
-                                     {"attack",
-                                      {"mc_after_attack_0.png",
-                                       "mc_after_attack_1.png",
-                                       "mc_after_attack_2.png",
-                                       "mc_attack_1.png",
-                                       "mc_attack_2.png",
-                                       "mc_idle.png"},
-                                      ATTACK_FRAME_DURATION,
-                                      {2, 3, 4, 0, 1, 2, 5}},
-
-                                     {"sprint",
-                                      {"mc_idle.png",
-                                       "mc_walk_left_1.png",
-                                       "mc_walk_left_2.png",
-                                       "mc_walk_right_1.png",
-                                       "mc_walk_right_2.png"},
-                                      FRAME_DURATION * PLAYER_SPEED_SPRINT_MUL,
-                                      {0, 1, 2, 1, 0, 3, 4, 3}},
-
-                                     {"dead",
-                                      {"mc_death_1.png",
-                                       "mc_death_2.png",
-                                       "mc_death_3.png",
-                                       "mc_death_4.png",
-                                       "mc_death_5.png",
-                                       "mc_death_6.png",
-                                       "mc_death_7.png"},
-                                      FRAME_DURATION}});
+        SetAnimations(AnimationLibrary::Instance().Load(renderer, SPRITE_FOLDER, Animations()));
+
+        // indices résolus une fois, Update ne compare plus de chaînes
+        idleClip = ClipIndex("idle");
+        walkClip = ClipIndex("walk");
+        attackClip = ClipIndex("attack");
+        sprintClip = ClipIndex("sprint");
+        deadClip = ClipIndex("dead");
 
         attack_speed_slide = Scene::Instance().CreateObject<SlideValue>();
         attack_speed_slide->SetParent(this);
@@ -101,8 +116,7 @@ public:
 
     void OnLevelChanged() override
     {
-        InitEnemies(Scene::Instance().GetCurrentLevel()->GetEnemies());
-        SetHP(maxHP);
+        SetHP(Health().maxHP);
         if (Scene::Instance().GetCurrentLevelIndex() == BOSS_LEVEL)
         {
             SoundManager::Instance().StopAll();
@@ -117,31 +131,17 @@ public:
         return autoLock;
     }
 
-    void InitEnemies(std::vector<std::shared_ptr<Object>> enemies_)
-    {
-        enemies = enemies_;
-    }
-
     Object *GetNearestEnemy(Vector2D pos)
     {
-        if (enemies.size() == 0)
-            return nullptr;
         Object *result = nullptr;
         float norm = 10000;
-        for (auto entity : enemies)
+        for (Object *enemy : Scene::Instance().GetLiveObjectsWithFlag(Flag_Enemy))
         {
-            Object *obj = entity.get();
-            Entity *enemy = dynamic_cast<Entity *>(obj);
-            if (enemy)
+            float thisnorm = (enemy->GetWorldPosition() - pos).norm1();
+            if (thisnorm < norm)
             {
-                if (enemy->IsDead())
-                    continue;
-                float thisnorm = (enemy->GetWorldPosition() - pos).norm1();
-                if (thisnorm < norm)
-                {
-                    norm = thisnorm;
-                    result = enemy;
-                }
+                norm = thisnorm;
+                result = enemy;
             }
         }
         return result;
@@ -158,16 +158,17 @@ public:
             autoLock = !autoLock;
         }
 
-        if (isDead)
+        if (IsDead())
         {
-            animationSystem->SetAnimation("dead", false);
+            Animation().Play(deadClip, false);
             attack_speed_slide->SetActive(false);
             return;
         }
 
         Vector2D worldPos = GetWorldPosition();
         float rotation = GetRotation();
-        Vector2D mousePos = Input::GetMousePosition() - worldPos;
+        // souris mesurée depuis le centre de l'écran, c'est-à-dire depuis la caméra (qui suit le joueur sur un monde en morceaux)
+        Vector2D mousePos = Input::GetMousePosition() + Scene::Instance().GetCamera()->GetWorldPosition() - worldPos;
 
         if (autoLock)
         {
@@ -238,11 +239,11 @@ public:
 
         if (attacking)
         {
-            attackRemaining -= deltaTime;
+            AttackComponent &attack = Attack();
 
-            attack_speed_slide->SetValue(attackRemaining / attackSpeed + 0.001f);
+            attack_speed_slide->SetValue(attack.remaining / attack.speed + 0.001f);
 
-            if (attackRemaining <= 0)
+            if (attack.remaining <= 0)
             {
                 attack_speed_slide->SetActive(false);
             }
@@ -253,7 +254,7 @@ public:
 
             if (!cinematic && Input::IsLeftClickDown())
             {
-                attackRemaining = attackSpeed;
+                Attack().remaining = Attack().speed;
                 attack_speed_slide->SetActive(true);
 
                 SoundManager::Instance().PlaySound("swing_sword");
@@ -269,7 +270,7 @@ public:
                 if (raycast.size() > 0)
                 {
 
-                    if (Entity *enemy = dynamic_cast<Entity *>(raycast[0]))
+                    if (Entity *enemy = raycast[0]->As<Entity>())
                     {
                         if (!enemy->IsDead())
                         {
@@ -279,7 +280,7 @@ public:
                     }
                 }
 
-                if (!did_death_animation && enemies.size() != 0 && AllEnemiesDead())
+                if (!did_death_animation && !Scene::Instance().GetObjectsWithFlag(Flag_Enemy).empty() && AllEnemiesDead())
                 {
                     if (Scene::Instance().GetCurrentLevelIndex() != BOSS_LEVEL)
                     {
@@ -298,21 +299,21 @@ public:
         // contrôler les animations
         if (attacking)
         {
-            animationSystem->SetAnimation("attack", false);
+            Animation().Play(attackClip, false);
         }
         else
         {
             if (velocity.zero())
             {
-                animationSystem->SetAnimation("idle", false);
+                Animation().Play(idleClip, false);
             }
             else if (IsSprinting)
             {
-                animationSystem->SetAnimation("sprint", true);
+                Animation().Play(sprintClip, true);
             }
             else
             {
-                animationSystem->SetAnimation("walk", true);
+                Animation().Play(walkClip, true);
             }
         }
     }
@@ -348,18 +349,7 @@ public:
 
     bool AllEnemiesDead()
     {
-        bool all_enemies_dead = true;
-        for (auto entity : enemies)
-        {
-            if (Entity *enemy = dynamic_cast<Entity *>(entity.get()))
-            {
-                if (!enemy->IsDead())
-                {
-                    return false;
-                }
-            }
-        }
-        return true;
+        return Scene::Instance().CountLiveObjectsWithFlag(Flag_Enemy) == 0;
     }
 
     void OnCollisionStay(Object *collision)
@@ -371,54 +361,44 @@ public:
             if (!Collision::ComputeMTV(this, collision, axis, overlap))
                 return;
 
-            Translate(-axis.x * overlap, -axis.y * overlap);
-
-            Vector2D tangent{-axis.y, axis.x};
-            float tlen = tangent.norm();
-            if (tlen > 0.0f)
-                tangent = tangent * (1.0f / tlen);
-
-            float dot = velocity.x * tangent.x + velocity.y * tangent.y;
-            Vector2D slideVel{tangent.x * dot, tangent.y * dot};
-
-            slideVel *= WALL_FRICTION;
-
-            float dt = Time::DeltaTime();
-            Translate(slideVel.x * dt, slideVel.y * dt);
+            SlideAgainstWall(axis, overlap);
         }
     }
 
-    void Render(SDL_Renderer *renderer, const Vector2D &givenPosition) override
+    void OnTileCollision(const Vector2D &axis, float overlap) override
     {
-        SDL_Texture *tex = animationSystem->Next(Time::DeltaTime());
+        SlideAgainstWall(axis, overlap);
+    }
 
-        int texW, texH;
-        SDL_QueryTexture(tex, nullptr, nullptr, &texW, &texH);
+    // sort du mur puis glisse le long avec la vitesse tangente freinée
+    void SlideAgainstWall(const Vector2D &axis, float overlap)
+    {
+        Translate(-axis.x * overlap, -axis.y * overlap);
 
-        int dstW = static_cast<int>(texW * TEXTURE_SCALE);
-        int dstH = static_cast<int>(texH * TEXTURE_SCALE);
+        Vector2D tangent{-axis.y, axis.x};
+        float tlen = tangent.norm();
+        if (tlen > 0.0f)
+            tangent = tangent * (1.0f / tlen);
 
-        SDL_Rect dst;
-        dst.w = dstW;
-        dst.h = dstH;
-        dst.x = static_cast<int>(givenPosition.x - dstW / 2.0f);
-        dst.y = static_cast<int>(givenPosition.y - dstH / 2.0f);
+        float dot = velocity.x * tangent.x + velocity.y * tangent.y;
+        Vector2D slideVel{tangent.x * dot, tangent.y * dot};
 
-        SDL_Point center{dstW / 2, dstH / 2};
+        slideVel *= WALL_FRICTION;
 
-        SDL_RenderCopyEx(renderer,
-                         tex,
-                         nullptr,
-                         &dst,
-                         GetRotation() + 90,
-                         &center,
-                         SDL_FLIP_NONE);
+        float dt = Time::DeltaTime();
+        Translate(slideVel.x * dt, slideVel.y * dt);
+    }
+
+    void Render(SDL_Renderer *renderer, const Vector2D &givenPosition) override
+    {
+        RenderSprite(renderer, givenPosition);
     }
 
 private:
     std::shared_ptr<SlideValue> attack_speed_slide;
     std::shared_ptr<EndVideo> cinematic_system;
-    std::vector<std::shared_ptr<Object>> enemies;
     bool autoLock;
     bool did_death_animation = false;
+
+    int idleClip = -1, walkClip = -1, attackClip = -1, sprintClip = -1, deadClip = -1;
 };
@@ -14,12 +14,6 @@ public:
         SetPosition(0.0f, 0.0f);
     }
 
-    ~ShadowPlayer()
-    {
-        if (shadow_img)
-            SDL_DestroyTexture(shadow_img);
-    }
-
     void Init(SDL_Renderer *renderer, Object* _parent, float sizeMultiplier)
     {
         collision = false;
@@ -28,37 +22,33 @@ public:
         SetRotation(.0f);
         renderDelimiter = (_parent->renderDelimiter) * sizeMultiplier;
 
-        SDL_Surface *surf = IMG_Load("Assets/Shadow.png");
-        if (!surf)
-        {
-            SDL_Log("Failed to load shadow: %s", IMG_GetError());
-            return;
-        }
-
-        shadow_img = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
-
+        shadow_img = TextureCache::Instance().Load(renderer, "Assets/Shadow.png");
         if (!shadow_img)
-        {
-            SDL_Log("Failed to create texture: %s", SDL_GetError());
             return;
-        }
 
         SetLayerOrder(0);
     }
 
     void Render(SDL_Renderer *_renderer, const Vector2D &givenPosition) override
     {
+        if (!shadow_img)
+            return;
+
         float offset_x = 0.0f, offset_y = 0.0f;
-        SDL_Rect rect;
+        SDL_FRect rect;
         rect.w = static_cast<int>(renderDelimiter.x * 2.0f);
         rect.h = static_cast<int>(renderDelimiter.y * 2.0f);
         rect.x = static_cast<int>(givenPosition.x - renderDelimiter.x + offset_x);
         rect.y = static_cast<int>(givenPosition.y - renderDelimiter.y + offset_y);
-        SDL_RenderCopy(_renderer, shadow_img, nullptr, &rect);
+        SpriteBatch::Instance().Draw(_renderer, shadow_img->sdl, shadow_img->width, shadow_img->height, {0, 0, shadow_img->width, shadow_img->height}, rect);
+    }
+
+    SDL_Texture *GetRenderTexture() const override
+    {
+        return shadow_img ? shadow_img->sdl : nullptr;
     }
 
 private:
     SDL_Renderer *renderer;
-    SDL_Texture *shadow_img;
+    TextureHandle shadow_img;
 };
\ No newline at end of file
@@ -46,34 +46,31 @@ public:
 
         if (SLIDER_OUTSCALE > 0)
         {
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-            SDL_Rect rect0;
+            SDL_FRect rect0;
             rect0.w = static_cast<int>(sx) + SLIDER_OUTSCALE * 2;
             rect0.h = static_cast<int>(sy) + SLIDER_OUTSCALE * 2;
             rect0.x = static_cast<int>(w1) - SLIDER_OUTSCALE;
             rect0.y = static_cast<int>(h) - SLIDER_OUTSCALE;
-            SDL_RenderFillRect(renderer, &rect0);
+            SpriteBatch::Instance().FillRect(renderer, rect0, {0, 0, 0, 255});
         }
 
         // dessiner le rectangle côté rempli
 
-        SDL_SetRenderDrawColor(renderer, color_fill.r, color_fill.g, color_fill.b, color_fill.a);
-        SDL_Rect rect1;
+        SDL_FRect rect1;
         rect1.w = static_cast<int>(sx1);
         rect1.h = static_cast<int>(sy);
         rect1.x = static_cast<int>(w1);
         rect1.y = static_cast<int>(h);
-        SDL_RenderFillRect(renderer, &rect1);
+        SpriteBatch::Instance().FillRect(renderer, rect1, color_fill);
 
         // dessiner le rectangle côté vide
 
-        SDL_SetRenderDrawColor(renderer, color_empty.r, color_empty.g, color_empty.b, color_empty.a);
-        SDL_Rect rect2;
+        SDL_FRect rect2;
         rect2.w = static_cast<int>(sx2);
         rect2.h = static_cast<int>(sy);
         rect2.x = static_cast<int>(w2);
         rect2.y = static_cast<int>(h);
-        SDL_RenderFillRect(renderer, &rect2);
+        SpriteBatch::Instance().FillRect(renderer, rect2, color_empty);
     }
 
 private:
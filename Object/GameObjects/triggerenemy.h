@@ -13,12 +13,6 @@ public:
         SetPosition(0.0f, 0.0f);
     }
 
-    ~TriggerEnemy()
-    {
-        if (trigger_img)
-            SDL_DestroyTexture(trigger_img);
-    }
-
     void Init(SDL_Renderer *renderer, Object* _parent, float size = 25.0f)
     {
         collision = false;
@@ -26,36 +20,32 @@ public:
         SetRotation(.0f);
         renderDelimiter = { size, size };
 
-        SDL_Surface *surf = IMG_Load("Assets/Hey.png");
-        if (!surf)
-        {
-            SDL_Log("Failed to load shadow: %s", IMG_GetError());
-            return;
-        }
-
-        trigger_img = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
-
+        trigger_img = TextureCache::Instance().Load(renderer, "Assets/Hey.png");
         if (!trigger_img)
-        {
-            SDL_Log("Failed to create texture: %s", SDL_GetError());
             return;
-        }
 
         SetLayerOrder(0);
     }
 
     void Render(SDL_Renderer *_renderer, const Vector2D &givenPosition) override
     {
+        if (!trigger_img)
+            return;
+
         float offset_x = 0.0f, offset_y = 0.0f;
-        SDL_Rect rect;
+        SDL_FRect rect;
         rect.w = static_cast<int>(renderDelimiter.x * 2.0f);
         rect.h = static_cast<int>(renderDelimiter.y * 2.0f);
         rect.x = static_cast<int>(givenPosition.x - renderDelimiter.x + offset_x);
         rect.y = static_cast<int>(givenPosition.y - renderDelimiter.y + offset_y);
-        SDL_RenderCopy(_renderer, trigger_img, nullptr, &rect);
+        SpriteBatch::Instance().Draw(_renderer, trigger_img->sdl, trigger_img->width, trigger_img->height, {0, 0, trigger_img->width, trigger_img->height}, rect);
+    }
+
+    SDL_Texture *GetRenderTexture() const override
+    {
+        return trigger_img ? trigger_img->sdl : nullptr;
     }
 
 private:
-    SDL_Texture *trigger_img;
+    TextureHandle trigger_img;
 };
\ No newline at end of file
@@ -39,13 +39,12 @@ public:
     {
         if (!debug_show) return;
 
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-        SDL_Rect rect;
+        SDL_FRect rect;
         rect.w = static_cast<int>(renderDelimiter.x * 2);
         rect.h = static_cast<int>(renderDelimiter.y * 2);
         rect.x = static_cast<int>(givenPosition.x - renderDelimiter.x);
         rect.y = static_cast<int>(givenPosition.y - renderDelimiter.y);
-        SDL_RenderFillRect(renderer, &rect);
+        SpriteBatch::Instance().FillRect(renderer, rect, color);
     }
 
 private:
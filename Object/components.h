@@ -0,0 +1,162 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Stockage contigu de composants (ensemble creux) : chaque composant est identifié par un handle stable,
+ * les données restent compactes pour être traitées en bloc par les systèmes.
+ */
+template <class T>
+class ComponentPool
+{
+public:
+    using Handle = uint32_t;
+    static constexpr Handle INVALID_HANDLE = UINT32_MAX;
+
+    static ComponentPool &Instance()
+    {
+        // jamais détruit : les entités de la scène sont libérées après les statiques locales
+        static ComponentPool *instance = new ComponentPool();
+        return *instance;
+    }
+
+    Handle Create(Object *owner, T component = T())
+    {
+        Handle handle;
+        if (!freeHandles.empty())
+        {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<Handle>(sparse.size());
+            sparse.push_back(INVALID_HANDLE);
+        }
+        sparse[handle] = static_cast<uint32_t>(dense.size());
+        dense.push_back(std::move(component));
+        owners.push_back(owner);
+        handles.push_back(handle);
+        return handle;
+    }
+
+    // retire le composant en déplaçant le dernier à sa place
+    void Destroy(Handle handle)
+    {
+        if (handle >= sparse.size() || sparse[handle] == INVALID_HANDLE)
+            return;
+
+        uint32_t index = sparse[handle];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (index != last)
+        {
+            dense[index] = std::move(dense[last]);
+            owners[index] = owners[last];
+            handles[index] = handles[last];
+            sparse[handles[index]] = index;
+        }
+        dense.pop_back();
+        owners.pop_back();
+        handles.pop_back();
+
+        sparse[handle] = INVALID_HANDLE;
+        freeHandles.push_back(handle);
+    }
+
+    // la référence n'est valable que jusqu'à la prochaine création / destruction
+    T &Get(Handle handle)
+    {
+        return dense[sparse[handle]];
+    }
+
+    bool Valid(Handle handle) const
+    {
+        return handle < sparse.size() && sparse[handle] != INVALID_HANDLE;
+    }
+
+    size_t Size() const
+    {
+        return dense.size();
+    }
+
+    // parcourt tous les composants avec leur propriétaire, dans l'ordre du stockage
+    template <class F>
+    void ForEach(F f)
+    {
+        for (size_t i = 0; i < dense.size(); ++i)
+        {
+            f(dense[i], owners[i]);
+        }
+    }
+
+private:
+    ComponentPool() = default;
+
+    std::vector<T> dense;
+    std::vector<Object *> owners;
+    std::vector<Handle> handles;
+    std::vector<uint32_t> sparse;
+    std::vector<Handle> freeHandles;
+};
+
+struct HealthComponent
+{
+    float maxHP = 100.0f;
+    float currentHP = 100.0f;
+    bool isDead = false;
+};
+
+struct AttackComponent
+{
+    float speed = 0.35f;     // durée d'une attaque
+    float remaining = 0.0f;  // temps restant avant de pouvoir attaquer à nouveau
+    float cast = 0.5f;
+    bool attacking = false;  // état au début de la frame, calculé par Combat::UpdateAttacks
+};
+
+namespace Combat
+{
+    /**
+     * Fait avancer en un seul passage les temps de recharge de toutes les attaques.
+     * Les entités inactives ou mortes ne sont pas mises à jour.
+     */
+    inline void UpdateAttacks(float deltaTime)
+    {
+        ComponentPool<AttackComponent>::Instance().ForEach([deltaTime](AttackComponent &attack, Object *owner)
+        {
+            if (!owner->IsActive() || owner->HasFlag(Flag_Dead))
+                return;
+
+            attack.attacking = attack.remaining > 0.0f;
+            if (attack.attacking)
+            {
+                attack.remaining -= deltaTime;
+            }
+        });
+    }
+}
+
+namespace Animations
+{
+    /**
+     * Fait avancer tous les lecteurs d'animation en un seul passage, après les mises à jour.
+     * Les entités inactives ou hors écran à la dernière frame ne sont pas animées.
+     * Sous charge (QualityGovernor), chaque lecteur n'avance qu'une frame sur n, de n fois la durée.
+     */
+    inline void UpdatePlayers(float deltaTime)
+    {
+        const QualityGovernor &governor = QualityGovernor::Instance();
+        int divisor = governor.Current().animation;
+        ComponentPool<AnimationPlayer>::Instance().ForEach([deltaTime, divisor, &governor](AnimationPlayer &player, Object *owner)
+        {
+            if (!owner->IsActive() || owner->invisible)
+                return;
+            if (!governor.RunsThisFrame(owner, divisor))
+                return;
+
+            player.Advance(deltaTime * divisor);
+        });
+    }
+}
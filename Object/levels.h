@@ -0,0 +1,252 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+// modèle nommé du manifeste : "enemy" (boss ou non) ou "obstacle" (taille en cases, image facultative)
+struct PrefabDefinition
+{
+    std::string type;
+    bool boss = false;
+    int width = 1, height = 1;
+    std::string sprite; // depuis le dossier du jeu
+};
+
+struct PrefabInstance
+{
+    std::string prefab;
+    Vector2D position;
+    std::vector<Vector2D> idlePoints;
+};
+
+struct LevelDefinition
+{
+    int index = 0;
+    std::string folder; // sous-dossier de Assets/Levels/, images et hitbox y sont relatives
+    std::vector<std::string> background, foreground;
+    std::string hitbox;
+    Vector2D spawn, exit;
+    std::vector<PrefabInstance> instances;
+    bool chunked = false; // monde en morceaux à la place des images et de la hitbox
+    ChunkSettings chunks;
+    std::string source; // entrée JSON d'origine, pour repérer les niveaux modifiés au rechargement
+};
+
+/**
+ * Niveaux décrits par un manifeste (Assets/Levels/levels.json) : images, hitbox, apparition, sortie et instances de prefabs.
+ * Un niveau avec "chunks" ({"folder", "cells", "min", "max"}, voir chunk_builder.py) est un monde en morceaux chargés autour de la caméra.
+ * À la construction d'un niveau, chaque prefab utilisé est résolu une fois puis toutes ses instances sont créées d'un bloc.
+ */
+class LevelManifest
+{
+public:
+    bool Load(const std::string &path)
+    {
+        std::string text;
+        if (!AssetPack::Instance().Read(path, text))
+        {
+            Debug::Error("LevelManifest: cannot open " + path);
+            return false;
+        }
+
+        nlohmann::json j = nlohmann::json::parse(text, nullptr, false);
+        if (j.is_discarded() || !j.is_object())
+        {
+            Debug::Error("LevelManifest: invalid JSON in " + path);
+            return false;
+        }
+
+        try
+        {
+            prefabsSource = j.at("prefabs").dump();
+            for (const auto &[name, item] : j.at("prefabs").items())
+            {
+                PrefabDefinition prefab;
+                prefab.type = item.at("type").get<std::string>();
+                prefab.boss = item.value("boss", false);
+                if (item.contains("size"))
+                {
+                    prefab.width = item.at("size").at(0).get<int>();
+                    prefab.height = item.at("size").at(1).get<int>();
+                }
+                prefab.sprite = item.value("sprite", std::string());
+                if (prefab.type != "enemy" && prefab.type != "obstacle")
+                {
+                    Debug::Error("LevelManifest: unknown prefab type '" + prefab.type + "' for '" + name + "'");
+                    continue;
+                }
+                prefabs[name] = prefab;
+            }
+
+            for (const auto &item : j.at("levels"))
+            {
+                LevelDefinition level;
+                level.index = item.at("index").get<int>();
+                level.folder = item.at("folder").get<std::string>();
+                level.background = item.value("background", std::vector<std::string>{});
+                level.foreground = item.value("foreground", std::vector<std::string>{});
+                level.hitbox = item.value("hitbox", std::string());
+                level.spawn = ReadPoint(item.at("spawn"));
+                level.exit = ReadPoint(item.at("exit"));
+                level.source = item.dump();
+
+                if (item.contains("chunks"))
+                {
+                    const auto &chunks = item.at("chunks");
+                    level.chunked = true;
+                    level.chunks.folder = "Assets/Levels/" + level.folder + chunks.value("folder", std::string());
+                    level.chunks.cells = chunks.value("cells", 100);
+                    level.chunks.minX = chunks.at("min").at(0).get<int>();
+                    level.chunks.minY = chunks.at("min").at(1).get<int>();
+                    level.chunks.maxX = chunks.at("max").at(0).get<int>();
+                    level.chunks.maxY = chunks.at("max").at(1).get<int>();
+                }
+
+                for (const auto &inst : item.value("instances", nlohmann::json::array()))
+                {
+                    PrefabInstance instance;
+                    instance.prefab = inst.at("prefab").get<std::string>();
+                    instance.position = ReadPoint(inst.at("position"));
+                    for (const auto &point : inst.value("idle", nlohmann::json::array()))
+                        instance.idlePoints.push_back(ReadPoint(point));
+
+                    if (!prefabs.count(instance.prefab))
+                    {
+                        Debug::Error("LevelManifest: level " + std::to_string(level.index) + " uses unknown prefab '" + instance.prefab + "'");
+                        continue;
+                    }
+                    level.instances.push_back(std::move(instance));
+                }
+                levels.push_back(std::move(level));
+            }
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            Debug::Error("LevelManifest: " + path + ": " + e.what());
+            return false;
+        }
+
+        Debug::Log("LevelManifest: " + std::to_string(levels.size()) + " levels, " + std::to_string(prefabs.size()) + " prefabs");
+        return true;
+    }
+
+    const std::vector<LevelDefinition> &Levels() const
+    {
+        return levels;
+    }
+
+    // indices des niveaux ajoutés ou modifiés dans other ; tous si les prefabs ont changé
+    std::vector<int> ChangedLevels(const LevelManifest &other) const
+    {
+        std::unordered_map<int, const std::string *> previous;
+        for (const LevelDefinition &level : levels)
+            previous[level.index] = &level.source;
+
+        std::vector<int> changed;
+        for (const LevelDefinition &level : other.levels)
+        {
+            auto it = previous.find(level.index);
+            if (other.prefabsSource != prefabsSource || it == previous.end() || *it->second != level.source)
+                changed.push_back(level.index);
+        }
+        return changed;
+    }
+
+    // ressources du niveau (images de fond, atlas des prefabs utilisés) ; onReady est laissé à l'appelant
+    AssetBundle Bundle(const LevelDefinition &level, std::vector<std::string> dependencies) const
+    {
+        AssetBundle bundle;
+        bundle.dependencies = std::move(dependencies);
+        for (const std::string &frame : level.background)
+            bundle.textures.push_back("Assets/Levels/" + level.folder + frame);
+        for (const std::string &frame : level.foreground)
+            bundle.textures.push_back("Assets/Levels/" + level.folder + frame);
+        if (level.chunked)
+        {
+            // les autres morceaux sont chargés pendant la partie
+            std::vector<std::string> chunks = level.chunks.TexturesAround(level.spawn, LEVEL_SIZE_FACTOR);
+            bundle.textures.insert(bundle.textures.end(), chunks.begin(), chunks.end());
+        }
+
+        bool usesEnemy = false, usesBoss = false;
+        for (const PrefabInstance &instance : level.instances)
+        {
+            const PrefabDefinition &prefab = prefabs.at(instance.prefab);
+            if (prefab.type == "obstacle")
+            {
+                if (!prefab.sprite.empty())
+                    bundle.textures.push_back(prefab.sprite);
+                continue;
+            }
+            (prefab.boss ? usesBoss : usesEnemy) = true;
+        }
+        if (usesEnemy || usesBoss)
+            bundle.textures.push_back("Assets/Hey.png"); // TriggerEnemy
+
+        for (bool boss : {false, true})
+        {
+            if (!(boss ? usesBoss : usesEnemy))
+                continue;
+            std::vector<std::string> images = AnimationSet::AtlasPaths(Enemy::SpriteFolder(boss), Enemy::Animations(boss));
+            bundle.images.insert(bundle.images.end(), images.begin(), images.end());
+        }
+        return bundle;
+    }
+
+    // crée le niveau et toutes ses instances, depuis le onReady de son bundle
+    auto Build(const LevelDefinition &def, SDL_Renderer *renderer, const std::shared_ptr<Entity> &player) const
+    {
+        Scene &scene = Scene::Instance();
+        std::string hitbox = def.hitbox.empty() ? "" : "Assets/Levels/" + def.folder + def.hitbox;
+        auto level = scene.CreateLevel(def.index, renderer, def.spawn, def.exit, def.folder, def.background, def.foreground, hitbox);
+        if (def.chunked)
+            level->InitChunks(def.chunks);
+
+        // un ennemi crée aussi son ombre, sa barre de vie et son déclencheur
+        scene.ReserveObjects(def.instances.size() * 4);
+
+        std::unordered_map<std::string, EnemyPrefab> resolved;
+        std::vector<std::shared_ptr<Object>> enemies;
+        enemies.reserve(def.instances.size());
+        for (const PrefabInstance &instance : def.instances)
+        {
+            // définition chargée avant un rechargement du manifeste qui a retiré ce prefab
+            auto prefab = prefabs.find(instance.prefab);
+            if (prefab == prefabs.end())
+                continue;
+
+            if (prefab->second.type == "obstacle")
+            {
+                auto obstacle = scene.CreateObject<Obstacle>(instance.position);
+                obstacle->Init(renderer, level.get(), prefab->second.width, prefab->second.height, prefab->second.sprite);
+                continue;
+            }
+
+            auto it = resolved.find(instance.prefab);
+            if (it == resolved.end())
+                it = resolved.emplace(instance.prefab, Enemy::MakePrefab(renderer, prefab->second.boss)).first;
+
+            auto enemy = scene.CreateObject<Enemy>(instance.position);
+            enemy->InitFromPrefab(renderer, it->second, instance.idlePoints);
+            enemy->SetPlayer(player);
+            enemy->SetNavigation(&level->GetNavigation());
+            enemies.push_back(enemy);
+        }
+        level->SetEnemies(enemies);
+        return level;
+    }
+
+private:
+    static Vector2D ReadPoint(const nlohmann::json &point)
+    {
+        return {point.at(0).get<float>(), point.at(1).get<float>()};
+    }
+
+    std::unordered_map<std::string, PrefabDefinition> prefabs;
+    std::vector<LevelDefinition> levels;
+    std::string prefabsSource;
+};
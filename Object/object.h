@@ -2,6 +2,9 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
 #include <SDL2/SDL.h>
 
 enum ObjectFlag
@@ -15,6 +18,35 @@ enum ObjectFlag
     Flag_Dead = 1 << 5,
 };
 
+static constexpr int OBJECT_FLAG_COUNT = 6;
+
+// bits de type posés à la construction par TypedObject, pour filtrer et convertir sans dynamic_cast
+enum ObjectType
+{
+    Type_None = 0,
+    Type_Entity = 1 << 0,
+    Type_Player = 1 << 1,
+    Type_Enemy = 1 << 2,
+};
+
+// partition des objets qui ne dépendent d'aucun niveau (joueur, caméra, UI...)
+static constexpr int GLOBAL_PARTITION = -1;
+
+class Object;
+
+// vue non propriétaire sur un tableau d'objets, valable jusqu'à la prochaine modification de l'index
+struct ObjectSpan
+{
+    Object *const *first = nullptr;
+    size_t count = 0;
+
+    Object *const *begin() const { return first; }
+    Object *const *end() const { return first + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    Object *operator[](size_t i) const { return first[i]; }
+};
+
 class Object
 {
 public:
@@ -28,7 +60,10 @@ public:
         movedThisFrame = false;
         Start();
     }
-    virtual ~Object() = default;
+    virtual ~Object()
+    {
+        UpdateFlagIndex(flags, partition, 0, partition);
+    }
 
     virtual void Start()
     {
@@ -36,9 +71,14 @@ public:
     virtual void Update(float deltaTime) {}
     virtual void Render(SDL_Renderer *renderer, const Vector2D &givenPosition) {}
 
+    // texture principale affichée, utilisée pour regrouper les rendus lors du tri
+    virtual SDL_Texture *GetRenderTexture() const { return nullptr; }
+
     virtual void OnCollisionEnter(Object *collision) {}
     virtual void OnCollisionStay(Object *collision) {}
     virtual void OnCollisionExit(Object *collision) {}
+    // contact avec le décor en cases (Collision::TileMap) ; axis va de l'objet vers le mur
+    virtual void OnTileCollision(const Vector2D &axis, float overlap) {}
 
     virtual void OnLevelChanged() { }
 
@@ -83,6 +123,12 @@ public:
 
     void SetLayerOrder(int order)
     {
+        if (order != layerOrder && renderEntry.queued && !renderEntry.pending)
+        {
+            // la file d'affichage sera corrigée avant le prochain rendu
+            renderEntry.pending = true;
+            pendingLayerChanges.push_back(this);
+        }
         layerOrder = order;
     }
 
@@ -98,8 +144,29 @@ public:
 
     void SetParent(Object *ptr_parent)
     {
+        if (ptr_parent == parent)
+            return;
+        // l'ancien parent ne doit plus entraîner l'objet dans ses changements de partition ou d'activité
+        if (parent)
+            parent->RemoveChild(this);
         parent = ptr_parent;
         parent->children.push_back(this);
+
+        SetPartition(parent->partition);
+        RefreshActiveInHierarchy();
+    }
+
+    // retire l'objet de la hiérarchie avant sa libération : ni son parent ni ses enfants ne gardent de pointeur vers lui
+    void DetachFromHierarchy()
+    {
+        if (parent)
+            parent->RemoveChild(this);
+        parent = nullptr;
+        for (auto child : children)
+        {
+            child->parent = nullptr;
+        }
+        children.clear();
     }
 
     bool IsSelfActive() const
@@ -107,9 +174,39 @@ public:
         return active;
     }
 
+    // état mis en cache, valable pour toute la hiérarchie des parents
     bool IsActive() const
     {
-        return IsSelfActive() && (parent == nullptr || parent->IsSelfActive());
+        return activeInHierarchy;
+    }
+
+    // partition (niveau) à laquelle l'objet appartient, héritée du parent
+    void SetPartition(int p)
+    {
+        // les enfants partagent toujours la partition de leur parent
+        if (p == partition)
+            return;
+
+        int previous = partition;
+        UpdateFlagIndex(flags, partition, flags, p);
+        partition = p;
+        if (partitionSlot != NO_PARTITION_SLOT && partitionListener)
+            partitionListener(this, previous);
+        for (auto child : children)
+        {
+            child->SetPartition(p);
+        }
+    }
+
+    // appelé à chaque changement de partition d'un objet de la scène, pour le déplacer d'une partition à l'autre
+    static void SetPartitionListener(void (*listener)(Object *object, int previous))
+    {
+        partitionListener = listener;
+    }
+
+    int GetPartition() const
+    {
+        return partition;
     }
 
     int GetLayerOrder() const
@@ -125,20 +222,31 @@ public:
     void SetActive(bool a)
     {
         active = a;
+        activeInHierarchy = a && (parent == nullptr || parent->activeInHierarchy);
         for (auto child : children)
         {
             child->SetActive(a);
         }
     }
 
+    void RefreshActiveInHierarchy()
+    {
+        activeInHierarchy = active && (parent == nullptr || parent->activeInHierarchy);
+        for (auto child : children)
+        {
+            child->RefreshActiveInHierarchy();
+        }
+    }
+
     void SetFlags(int new_flags)
     {
+        UpdateFlagIndex(flags, partition, new_flags, partition);
         flags = new_flags;
     }
 
     void AddFlags(int new_flags)
     {
-        flags |= new_flags;
+        SetFlags(flags | new_flags);
     }
 
     bool HasFlag(int f) const
@@ -153,7 +261,19 @@ public:
 
     void RemoveFlag(int f)
     {
-        flags &= ~f;
+        SetFlags(flags & ~f);
+    }
+
+    // objets d'une partition portant le flag donné
+    static ObjectSpan WithFlag(ObjectFlag flag, int partition)
+    {
+        return FlagSet(flag, partition, false);
+    }
+
+    // objets d'une partition portant le flag donné, sans Flag_Dead
+    static ObjectSpan LiveWithFlag(ObjectFlag flag, int partition)
+    {
+        return FlagSet(flag, partition, true);
     }
 
     void Destroy()
@@ -161,16 +281,59 @@ public:
         destroyed = true;
     }
 
+    bool IsDestroyed() const
+    {
+        return destroyed;
+    }
+
+    uint32_t GetTypeMask() const
+    {
+        return typeMask;
+    }
+
+    bool IsType(uint32_t mask) const
+    {
+        return (typeMask & mask) == mask;
+    }
+
+    // conversion vérifiée par un test de bits, T doit dériver de TypedObject<T, ...>
+    template <class T>
+    T *As()
+    {
+        return IsType(T::TYPE) ? static_cast<T *>(this) : nullptr;
+    }
+
     Vector2D renderDelimiter;
     Vector2D collisionDelimiter;
     bool collision = false;
     bool delimiterAffectedByRotation = false;
 
-    bool invisible;
+    bool invisible = false;
+    bool screenSpace = false; // position par rapport au centre de l'écran : ni déplacé par la caméra ni écarté par Cull (écrans plein écran)
+    float skippedTime = 0.0f; // mises à jour sautées par QualityGovernor, rendues à la suivante
 
     Object *parent = nullptr;
     std::vector<Object *> children;
 
+    // position de l'objet dans la file d'affichage (voir RenderQueue)
+    struct RenderEntry
+    {
+        bool queued = false;
+        bool pending = false;
+        int layer = 0;
+        uint64_t sequence = 0;
+    } renderEntry;
+
+    // position dans le tableau de sa partition de scène, NO_PARTITION_SLOT hors de la scène
+    static constexpr size_t NO_PARTITION_SLOT = static_cast<size_t>(-1);
+    size_t partitionSlot = NO_PARTITION_SLOT;
+
+    // objets dont l'ordre de calque a changé depuis le dernier rendu
+    static std::vector<Object *> &PendingLayerChanges()
+    {
+        return pendingLayerChanges;
+    }
+
     bool operator==(std::nullptr_t) const { return destroyed; }
     bool operator!=(std::nullptr_t) const { return !destroyed; }
     friend bool operator==(std::nullptr_t, const Object &o) { return o == nullptr; }
@@ -180,12 +343,101 @@ public:
 
     virtual void OnDestroy() {}
 
+protected:
+    uint32_t typeMask = Type_None;
+
 private:
     Vector2D position;
-    int layerOrder;
+    int layerOrder = 0;
     bool active;
+    bool activeInHierarchy = true;
+    int partition = GLOBAL_PARTITION;
     bool movedThisFrame;
     float rotation;
-    int flags;
+    int flags = 0;
     bool destroyed = false;
-};
\ No newline at end of file
+
+    // position dans les ensembles de flagIndex, -1 si absent ([0] tous, [1] vivants)
+    int flagSlots[2][OBJECT_FLAG_COUNT] = {{-1, -1, -1, -1, -1, -1}, {-1, -1, -1, -1, -1, -1}};
+
+    // pour chaque partition et chaque flag : tableaux denses des objets porteurs (tous, vivants)
+    struct FlagSets
+    {
+        std::vector<Object *> members[2][OBJECT_FLAG_COUNT];
+    };
+    static inline std::unordered_map<int, FlagSets> flagIndex;
+
+    static ObjectSpan FlagSet(ObjectFlag flag, int partition, bool live)
+    {
+        auto it = flagIndex.find(partition);
+        if (it == flagIndex.end())
+            return {};
+        for (int bit = 0; bit < OBJECT_FLAG_COUNT; ++bit)
+        {
+            if (flag == (1 << bit))
+            {
+                const std::vector<Object *> &members = it->second.members[live][bit];
+                return {members.data(), members.size()};
+            }
+        }
+        return {};
+    }
+
+    void InsertInFlagSet(int set, int bit, int p)
+    {
+        std::vector<Object *> &members = flagIndex[p].members[set][bit];
+        flagSlots[set][bit] = static_cast<int>(members.size());
+        members.push_back(this);
+    }
+
+    void RemoveFromFlagSet(int set, int bit, int p)
+    {
+        std::vector<Object *> &members = flagIndex[p].members[set][bit];
+        int slot = flagSlots[set][bit];
+        Object *last = members.back();
+        members[slot] = last;
+        last->flagSlots[set][bit] = slot;
+        members.pop_back();
+        flagSlots[set][bit] = -1;
+    }
+
+    // ajoute / retire l'objet des ensembles concernés par le changement de flags ou de partition
+    void UpdateFlagIndex(int oldFlags, int oldPartition, int newFlags, int newPartition)
+    {
+        bool moved = oldPartition != newPartition;
+        for (int bit = 0; bit < OBJECT_FLAG_COUNT; ++bit)
+        {
+            int f = 1 << bit;
+            bool was[2] = {(oldFlags & f) != 0, (oldFlags & f) != 0 && !(oldFlags & Flag_Dead)};
+            bool is[2] = {(newFlags & f) != 0, (newFlags & f) != 0 && !(newFlags & Flag_Dead)};
+            for (int set = 0; set < 2; ++set)
+            {
+                if (was[set] && (!is[set] || moved))
+                    RemoveFromFlagSet(set, bit, oldPartition);
+                if (is[set] && (!was[set] || moved))
+                    InsertInFlagSet(set, bit, newPartition);
+            }
+        }
+    }
+
+    static inline void (*partitionListener)(Object *, int) = nullptr;
+
+    void RemoveChild(Object *child)
+    {
+        auto it = std::find(children.begin(), children.end(), child);
+        if (it != children.end())
+            children.erase(it);
+    }
+    static inline std::vector<Object *> pendingLayerChanges;
+};
+
+// donne à Derived son bit de type à la construction : class Entity : public TypedObject<Entity, Object>
+template <class Derived, class Base = Object>
+class TypedObject : public Base
+{
+public:
+    TypedObject()
+    {
+        this->typeMask |= Derived::TYPE;
+    }
+};
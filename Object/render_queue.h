@@ -0,0 +1,99 @@
+#pragma once
+
+#include <set>
+#include <cstdint>
+
+/**
+ * File d'affichage triée par (ordre de calque, numéro de création).
+ * Un changement de calque ne coûte qu'une suppression et une insertion en O(log n),
+ * l'ordre d'affichage est indépendant de l'ordre de mise à jour.
+ */
+class RenderQueue
+{
+public:
+    struct Key
+    {
+        int layer;
+        uint64_t sequence;
+        Object *object;
+
+        bool operator<(const Key &o) const
+        {
+            if (layer != o.layer)
+                return layer < o.layer;
+            return sequence < o.sequence;
+        }
+    };
+
+    void Insert(Object *object)
+    {
+        Object::RenderEntry &entry = object->renderEntry;
+        if (entry.sequence == 0)
+            entry.sequence = nextSequence++;
+        entry.layer = object->GetLayerOrder();
+        entry.queued = true;
+        keys.insert({entry.layer, entry.sequence, object});
+    }
+
+    void Remove(Object *object)
+    {
+        Object::RenderEntry &entry = object->renderEntry;
+        if (!entry.queued)
+            return;
+        keys.erase({entry.layer, entry.sequence, object});
+        entry.queued = false;
+    }
+
+    // replace l'objet selon son nouvel ordre de calque
+    void Reorder(Object *object)
+    {
+        Remove(object);
+        Insert(object);
+    }
+
+    void Clear()
+    {
+        for (auto &key : keys)
+        {
+            key.object->renderEntry.queued = false;
+        }
+        keys.clear();
+    }
+
+    size_t Size() const
+    {
+        return keys.size();
+    }
+
+    std::set<Key>::const_iterator begin() const { return keys.begin(); }
+    std::set<Key>::const_iterator end() const { return keys.end(); }
+
+    // parcourt deux files dans l'ordre d'affichage global, sans les fusionner en mémoire
+    template <class F>
+    static void Merge(const RenderQueue *a, const RenderQueue *b, F f)
+    {
+        static const RenderQueue empty;
+        if (!a) a = &empty;
+        if (!b) b = &empty;
+
+        auto ia = a->begin(), ib = b->begin();
+        while (ia != a->end() || ib != b->end())
+        {
+            if (ib == b->end() || (ia != a->end() && *ia < *ib))
+            {
+                f(ia->object);
+                ++ia;
+            }
+            else
+            {
+                f(ib->object);
+                ++ib;
+            }
+        }
+    }
+
+private:
+    std::set<Key> keys;
+
+    static inline uint64_t nextSequence = 1;
+};
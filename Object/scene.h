@@ -1,15 +1,26 @@
 #pragma once
 
 #include <camera.h>
+#include <render_queue.h>
 #include <vector>
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <set>
+#include <functional>
 #include <algorithm>
+#include <cmath>
 
 #include <SDL2/SDL.h>
 
 using SceneObject = std::shared_ptr<Object>;
 
+enum class RenderMode
+{
+    LayerOrder, // ordre de calque puis ordre de création
+    YSorted     // ordre de calque, puis position verticale, puis texture
+};
+
 static constexpr float LEVEL_SIZE_FACTOR = 10.0f;
 
 class Scene
@@ -29,7 +40,8 @@ public:
     void AddObject(SceneObject object)
     {
         objects.push_back(object);
-        std::push_heap(objects.begin(), objects.end(), CompareLayer);
+
+        InsertInPartition(object.get());
     }
 
     void SetPlayer(SceneObject p)
@@ -37,13 +49,11 @@ public:
         player = p;
     }
 
-    std::vector<Object *> GetRawObjectPointers() const
+    // objets de la partition globale et du niveau courant
+    const std::vector<Object *> &GetRawObjectPointers()
     {
-        std::vector<Object *> raw;
-        raw.reserve(objects.size());
-        for (auto &o : objects)
-            raw.push_back(o.get());
-        return raw;
+        RefreshActiveObjects();
+        return activeObjects;
     }
 
     void SetCamera(std::shared_ptr<Camera> cam)
@@ -52,6 +62,12 @@ public:
         camera = cam;
     }
 
+    // avant une création en bloc (instances d'un niveau) : une seule réallocation
+    void ReserveObjects(size_t count)
+    {
+        objects.reserve(objects.size() + count);
+    }
+
     template <class T>
     std::shared_ptr<T> CreateObject(Vector2D position = {0.0f, 0.0f}, float rotation = 0.0f)
     {
@@ -71,7 +87,8 @@ public:
     }
 
     #include <gamelevel.h>
-    std::shared_ptr<GameLevel> CreateLevel(SDL_Renderer *renderer,
+    std::shared_ptr<GameLevel> CreateLevel(int index,
+        SDL_Renderer *renderer,
         Vector2D spawn,
         Vector2D exitpos,
         std::string mainPath,
@@ -84,18 +101,20 @@ public:
             this,
             LEVEL_SIZE_FACTOR,
             spawn,
+            exitpos,
             std::string("Levels/") + mainPath, 
             backgroundSpritePaths,
             foregroundSpritePaths,
             rectsPath);
         level->SetLayerOrder(-1);
+        level->SetPartition(index);
 
-        levels[levelCount++] = level;
+        levels[index] = level;
 
         auto exit = CreateObject<Exit>();
         exit->Init(EXIT_SIZE, EXIT_SIZE);
         exit->SetParent(level.get());
-        exit->SetPosition(exitpos);
+        exit->SetPosition(level->ExitPoint());
 
         return level;
     }
@@ -113,9 +132,108 @@ public:
 
 
 
+    /**
+     * Niveau chargé à la demande : bundle des ressources, dont onReady crée le niveau (CreateLevel avec cet indice)
+     * et ses objets. Un niveau enregistré peut être déchargé puis recréé.
+     */
+    void RegisterLevel(int index, AssetBundle bundle)
+    {
+        definitions[index] = std::move(bundle);
+    }
+
+    // lance le chargement en arrière-plan d'un niveau enregistré qui n'est pas en mémoire
+    void RequestLevel(int index)
+    {
+        auto def = definitions.find(index);
+        if (def == definitions.end() || levels.count(index) || loadingLevels.count(index))
+            return;
+
+        AssetBundle bundle = def->second;
+        bundle.name = "level" + std::to_string(index) + "#" + std::to_string(++levelLoads);
+        std::function<void()> build = bundle.onReady;
+        std::string name = bundle.name;
+        bundle.onReady = [this, index, build, name]()
+        {
+            build();
+            loadingLevels.erase(index);
+            LevelResidency &residency = residencies[index];
+            residency.bytes = AssetLoader::Instance().Bytes(name);
+            residency.bundle = name;
+            residency.leftFrame = frameCount;
+        };
+
+        loadingLevels.insert(index);
+        AssetLoader::Instance().Enqueue(std::move(bundle));
+    }
+
+    // rechargement à chaud d'une hitbox : seuls les niveaux en mémoire qui l'utilisent sont reconstruits
+    int ReloadLevelGeometry(const std::string &path)
+    {
+        int reloaded = 0;
+        for (auto &[index, level] : levels)
+        {
+            if (level->ReloadGeometry(path))
+                ++reloaded;
+        }
+        return reloaded;
+    }
+
+    /**
+     * Définition du niveau modifiée (manifeste rechargé à chaud) : le niveau en mémoire est déchargé,
+     * puis recréé aussitôt s'il est le niveau courant, le joueur revenant à son apparition.
+     */
+    void ReloadLevel(int index)
+    {
+        if (loadingLevels.count(index))
+        {
+            Debug::Error("Scene: level " + std::to_string(index) + " is loading, its changes apply at the next load");
+            return;
+        }
+        if (!levels.count(index))
+            return;
+
+        EvictLevel(index);
+        if (index == currentLevelIndex)
+            SetLevel(index);
+    }
+
+    // vrai tant qu'un changement de niveau attend la fin d'un chargement
+    bool IsLevelPending() const
+    {
+        return pendingLevel >= 0;
+    }
+
+    /**
+     * Une fois par frame, avant la mise à jour : bascule vers le niveau attendu s'il vient d'être créé,
+     * puis décharge les niveaux quittés si leur mémoire dépasse LEVEL_MEMORY_BUDGET_MB.
+     */
+    void UpdateStreaming()
+    {
+        ++frameCount;
+        if (pendingLevel >= 0 && levels.count(pendingLevel))
+        {
+            SetLevel(pendingLevel);
+        }
+        EvictLevels();
+    }
+
     void SetLevel(int index)
     {
+        if (!levels.count(index) && definitions.count(index))
+        {
+            // la bascule se fera dans UpdateStreaming, une fois le niveau créé
+            RequestLevel(index);
+            pendingLevel = index;
+            return;
+        }
+        pendingLevel = -1;
+
+        if (index != currentLevelIndex && residencies.count(currentLevelIndex))
+        {
+            residencies[currentLevelIndex].leftFrame = frameCount;
+        }
         currentLevelIndex = index;
+        activeObjectsDirty = true;
         Vector2D spawnpoint = {0.0f, 0.0f};
         bool player_allowed = true;
         for (auto &[levelindex, level] : levels)
@@ -132,25 +250,42 @@ public:
             }
         }
 
-        player->SetActive(player_allowed);
-        if (player_allowed)
+        if (player)
         {
-            player->SetPosition(spawnpoint);
-            player->SetRotation(0.0f);
-            player->OnLevelChanged();
+            player->SetActive(player_allowed);
+            if (player_allowed)
+            {
+                player->SetPosition(spawnpoint);
+                player->SetRotation(0.0f);
+                player->OnLevelChanged();
+            }
         }
+
+        // le niveau suivant se charge pendant que celui-ci est joué
+        RequestLevel(index + 1);
     }
 
     void NextLevel()
     {
-        currentLevelIndex++;
-        currentLevelIndex %= levels.size();
-        SetLevel(currentLevelIndex);
+        if (IsLevelPending())
+            return;
+        SetLevel((currentLevelIndex + 1) % LevelCount());
+    }
+
+    // niveaux connus, en mémoire ou non
+    int LevelCount() const
+    {
+        int count = levels.empty() ? 0 : levels.rbegin()->first + 1;
+        if (!definitions.empty())
+            count = std::max(count, definitions.rbegin()->first + 1);
+        return count;
     }
 
     std::shared_ptr<GameLevel> GetCurrentLevel()
     {
-        return levels[currentLevelIndex];
+        // find : levels sert aussi à savoir quels niveaux sont en mémoire, rien ne doit y être ajouté ici
+        auto it = levels.find(currentLevelIndex);
+        return it != levels.end() ? it->second : nullptr;
     }
     int GetCurrentLevelIndex()
     {
@@ -159,61 +294,99 @@ public:
 
     void UpdateAll(float deltaTime)
     {
-        for (auto &obj : objects)
+        RefreshActiveObjects();
+
+        // ennemis mis à jour moins souvent quand les frames dépassent le budget, avec le temps écoulé depuis leur dernier tour
+        QualityGovernor &governor = QualityGovernor::Instance();
+        const QualityGovernor::Level &quality = governor.Current();
+
+        // la liste n'est pas reconstruite pendant le parcours, même si le niveau change
+        iterating = true;
+        for (Object *obj : activeObjects)
         {
-            if (obj->IsActive())
+            if (!obj->IsActive())
+                continue;
+
+            int divisor = obj->HasFlag(Flag_Enemy) ? (obj->invisible ? quality.aiOffscreen : quality.aiOnscreen) : 1;
+            if (divisor > 1 || obj->skippedTime > 0.0f)
             {
-                obj->Update(deltaTime);
+                obj->skippedTime += deltaTime;
+                if (!governor.RunsThisFrame(obj, divisor))
+                    continue;
+                float elapsed = obj->skippedTime;
+                obj->skippedTime = 0.0f;
+                obj->Update(elapsed);
+                continue;
             }
+            obj->Update(deltaTime);
         }
+        iterating = false;
     }
 
-    std::vector<SceneObject> GetObjectsWithFlags(int flags)
+    // objets du niveau courant portant le flag, sans copie
+    ObjectSpan GetObjectsWithFlag(ObjectFlag flag) const
     {
-        std::vector<SceneObject> result;
-        for (SceneObject obj: objects)
-        {
-            if (obj->HasFlag(flags))
-            {
-                result.push_back(obj);
-            }
-        }
-        return result;
+        return Object::WithFlag(flag, currentLevelIndex);
+    }
+
+    // objets vivants (sans Flag_Dead) du niveau courant portant le flag
+    ObjectSpan GetLiveObjectsWithFlag(ObjectFlag flag) const
+    {
+        return Object::LiveWithFlag(flag, currentLevelIndex);
+    }
+
+    size_t CountLiveObjectsWithFlag(ObjectFlag flag) const
+    {
+        return GetLiveObjectsWithFlag(flag).size();
     }
 
     void RenderAll(SDL_Renderer *renderer)
     {
+        RefreshActiveObjects();
+        UpdateLayerOrder();
+
         Vector2D camPos = camera->GetWorldPosition();
         Vector2D viewport = camera->GetViewportSize();
-        for (auto &obj : objects)
+        iterating = true;
+        if (renderMode == RenderMode::YSorted)
         {
-            if (obj->IsActive())
+            RenderYSorted(renderer, camPos, viewport);
+        }
+        else
+        {
+            RenderQueue::Merge(GetRenderQueue(GLOBAL_PARTITION), GetRenderQueue(currentLevelIndex), [&](Object *obj)
             {
-                Vector2D worldPos = obj->GetWorldPosition();
-
-                Vector2D givenPosition = {worldPos.x - camPos.x + viewport.x / 2.f, worldPos.y - camPos.y + viewport.y / 2.f};
-                Vector2D delimiter = obj->renderDelimiter;
-                if (givenPosition.x - delimiter.x > viewport.x ||
-                    givenPosition.x + delimiter.x < 0 ||
-                    givenPosition.y - delimiter.y > viewport.y ||
-                    givenPosition.y + delimiter.y < 0)
+                Vector2D givenPosition;
+                if (Cull(obj, camPos, viewport, givenPosition))
                 {
-                    obj->SetInvisible(true);
-                }
-                else
-                {
-                    obj->SetInvisible(false);
                     obj->Render(renderer, givenPosition);
                 }
-            }
+            });
         }
-        for (auto &[levelindex, level] : levels)
+        iterating = false;
+
+        auto current = levels.find(currentLevelIndex);
+        if (current != levels.end() && current->second->IsActive())
         {
-            if (level->IsActive())
-            {
-                level->PostRender(renderer);
-            }
+            current->second->PostRender(renderer);
         }
+        SpriteBatch::Instance().Flush();
+    }
+
+    void SetRenderMode(RenderMode mode)
+    {
+        renderMode = mode;
+    }
+
+    RenderMode GetRenderMode() const
+    {
+        return renderMode;
+    }
+
+    // durée du dernier tri des clés d'affichage, en millisecondes
+    float GetLastSortTime() const
+    {
+        return lastSortTime;
     }
 
     void DestroyObject(SceneObject obj)
@@ -227,26 +400,49 @@ public:
 
     void ClearDestroyedObject()
     {
+        if (destroyedObject.empty())
+            return;
+
+        // la liste des changements de calque ne doit pas garder de pointeurs vers des objets libérés
+        auto &pending = Object::PendingLayerChanges();
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [](Object *obj)
+        {
+            return obj->IsDestroyed();
+        }), pending.end());
+
         while (!destroyedObject.empty())
         {
             auto object = destroyedObject.front();
             object->OnDestroy();
+            object->DetachFromHierarchy();
+            RemoveFromPartition(object.get(), object->GetPartition());
 
             // destroy the object, bye bye
             object.reset();
             destroyedObject.pop();
         }
+
+        objects.erase(std::remove_if(objects.begin(), objects.end(), [](const SceneObject &obj)
+        {
+            return obj->IsDestroyed();
+        }), objects.end());
     }
 
+    // replace dans leur file d'affichage les objets dont le calque a changé
     void UpdateLayerOrder()
     {
-        std::stable_sort(
-            objects.begin(), 
-            objects.end(),
-            [](const SceneObject &a, const SceneObject &b){
-                return a->GetLayerOrder() < b->GetLayerOrder();
+        if (iterating)
+            return;
+
+        for (Object *obj : Object::PendingLayerChanges())
+        {
+            obj->renderEntry.pending = false;
+            if (obj->renderEntry.queued)
+            {
+                partitions[obj->GetPartition()].renderQueue.Reorder(obj);
             }
-        );
+        }
+        Object::PendingLayerChanges().clear();
     }
 
     std::shared_ptr<Camera> GetCamera() const
@@ -255,7 +451,13 @@ public:
     }
 
 private:
-    Scene() = default;
+    Scene()
+    {
+        Object::SetPartitionListener([](Object *object, int previous)
+        {
+            Instance().MovePartition(object, previous);
+        });
+    }
     ~Scene() = default;
 
     SceneObject player;
@@ -263,13 +465,234 @@ private:
     std::vector<SceneObject> objects;
     std::shared_ptr<GameOver> game_over;
     std::shared_ptr<Camera> camera;
-    std::map<int, std::shared_ptr<GameLevel>> levels;
-    int levelCount = 0, currentLevelIndex = 0;
+    std::map<int, std::shared_ptr<GameLevel>> levels; // niveaux en mémoire
+    int currentLevelIndex = 0;
+
+    // chargement à la demande
+    struct LevelResidency
+    {
+        size_t bytes = 0;
+        std::string bundle;         // oublié par l'AssetLoader quand le niveau est déchargé
+        unsigned int leftFrame = 0; // dernière frame où le niveau était courant
+    };
+
+    std::map<int, AssetBundle> definitions;
+    std::map<int, LevelResidency> residencies; // niveaux enregistrés actuellement en mémoire
+    std::set<int> loadingLevels;
+    int pendingLevel = -1;
+    unsigned int levelLoads = 0;
+    unsigned int frameCount = 0;
+
+    // les paires de collision de l'ancien niveau sont encore signalées (OnCollisionExit) la frame suivant la bascule
+    static constexpr unsigned int EVICT_DELAY_FRAMES = 2;
+
+    /**
+     * Décharge les niveaux quittés, du plus anciennement joué au plus récent, tant que la mémoire
+     * des niveaux enregistrés dépasse le budget. Le niveau courant et le suivant sont gardés.
+     */
+    void EvictLevels()
+    {
+        size_t budget = static_cast<size_t>(LEVEL_MEMORY_BUDGET_MB * 1024 * 1024);
+        size_t total = 0;
+        std::vector<std::pair<unsigned int, int>> candidates; // (leftFrame, indice)
+        for (auto &[index, residency] : residencies)
+        {
+            total += residency.bytes;
+            bool kept = index == currentLevelIndex || index == currentLevelIndex + 1 || index == pendingLevel;
+            if (!kept && frameCount - residency.leftFrame >= EVICT_DELAY_FRAMES)
+                candidates.push_back({residency.leftFrame, index});
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        for (auto &[leftFrame, index] : candidates)
+        {
+            if (total <= budget)
+                break;
+            total -= residencies[index].bytes;
+            EvictLevel(index);
+        }
+    }
+
+    // détruit le niveau et tous les objets de sa partition ; ils sont libérés par ClearDestroyedObject
+    void EvictLevel(int index)
+    {
+        for (auto &obj : objects)
+        {
+            if (obj->GetPartition() == index && !obj->IsDestroyed())
+                DestroyObject(obj);
+        }
+        Debug::Log("Scene: level " + std::to_string(index) + " unloaded (" +
+                   std::to_string(residencies[index].bytes / 1024) + " Ko)");
+        AssetLoader::Instance().Release(residencies[index].bundle);
+        levels.erase(index);
+        residencies.erase(index);
+    }
 
     std::queue<SceneObject> destroyedObject;
 
-    static bool CompareLayer(const SceneObject &a, const SceneObject &b)
+    // objets regroupés par niveau propriétaire ; seules les partitions globale et courante sont parcourues
+    struct ScenePartition
+    {
+        std::vector<Object *> objects; // ordre de mise à jour
+        RenderQueue renderQueue;       // ordre d'affichage
+    };
+
+    std::map<int, ScenePartition> partitions;
+    std::vector<Object *> activeObjects;
+    bool activeObjectsDirty = true;
+    bool iterating = false;
+
+    void InsertInPartition(Object *object)
+    {
+        ScenePartition &partition = partitions[object->GetPartition()];
+        object->partitionSlot = partition.objects.size();
+        partition.objects.push_back(object);
+        partition.renderQueue.Insert(object);
+        activeObjectsDirty = true;
+    }
+
+    // retrait en O(1) du tableau (le dernier objet prend la place) et en O(log n) de la file d'affichage
+    void RemoveFromPartition(Object *object, int index)
+    {
+        size_t slot = object->partitionSlot;
+        auto it = partitions.find(index);
+        if (slot == Object::NO_PARTITION_SLOT || it == partitions.end())
+            return;
+
+        std::vector<Object *> &members = it->second.objects;
+        Object *last = members.back();
+        members[slot] = last;
+        last->partitionSlot = slot;
+        members.pop_back();
+        it->second.renderQueue.Remove(object);
+        object->partitionSlot = Object::NO_PARTITION_SLOT;
+        activeObjectsDirty = true;
+    }
+
+    void MovePartition(Object *object, int previous)
+    {
+        RemoveFromPartition(object, previous);
+        InsertInPartition(object);
+    }
+
+    void RefreshActiveObjects()
+    {
+        if (iterating)
+            return;
+
+        if (!activeObjectsDirty)
+            return;
+
+        activeObjects.clear();
+        for (int index : {GLOBAL_PARTITION, currentLevelIndex})
+        {
+            auto it = partitions.find(index);
+            if (it != partitions.end())
+            {
+                activeObjects.insert(activeObjects.end(), it->second.objects.begin(), it->second.objects.end());
+            }
+        }
+        activeObjectsDirty = false;
+    }
+
+    RenderMode renderMode = RenderMode::LayerOrder;
+
+    struct VisibleObject
+    {
+        Object *object;
+        Vector2D givenPosition;
+    };
+
+    // tampons réutilisés d'une frame à l'autre par le rendu trié selon y
+    std::vector<VisibleObject> visibleObjects;
+    std::vector<Sort::KeyIndex> sortKeys, sortScratch;
+    std::unordered_map<SDL_Texture *, uint16_t> textureIds;
+    float lastSortTime = 0.0f;
+
+    // calcule la position à l'écran et indique si l'objet doit être affiché
+    static bool Cull(Object *obj, const Vector2D &camPos, const Vector2D &viewport, Vector2D &givenPosition)
+    {
+        if (!obj->IsActive())
+            return false;
+
+        Vector2D worldPos = obj->GetWorldPosition();
+        if (obj->screenSpace)
+        {
+            givenPosition = {worldPos.x + viewport.x / 2.f, worldPos.y + viewport.y / 2.f};
+            obj->SetInvisible(false);
+            return true;
+        }
+
+        givenPosition = {worldPos.x - camPos.x + viewport.x / 2.f, worldPos.y - camPos.y + viewport.y / 2.f};
+        Vector2D delimiter = obj->renderDelimiter;
+        if (givenPosition.x - delimiter.x > viewport.x ||
+            givenPosition.x + delimiter.x < 0 ||
+            givenPosition.y - delimiter.y > viewport.y ||
+            givenPosition.y + delimiter.y < 0)
+        {
+            obj->SetInvisible(true);
+            return false;
+        }
+        obj->SetInvisible(false);
+        return true;
+    }
+
+    /**
+     * Construit une clé 64 bits (calque 16 bits, y 32 bits, texture 16 bits) pour chaque objet visible,
+     * les trie par base puis les affiche : les entités se recouvrent selon leur position verticale
+     * et les rendus d'une même texture se suivent.
+     */
+    void RenderYSorted(SDL_Renderer *renderer, const Vector2D &camPos, const Vector2D &viewport)
+    {
+        visibleObjects.clear();
+        RenderQueue::Merge(GetRenderQueue(GLOBAL_PARTITION), GetRenderQueue(currentLevelIndex), [&](Object *obj)
+        {
+            Vector2D givenPosition;
+            if (Cull(obj, camPos, viewport, givenPosition))
+            {
+                visibleObjects.push_back({obj, givenPosition});
+            }
+        });
+
+        Uint64 start = SDL_GetPerformanceCounter();
+
+        textureIds.clear();
+        sortKeys.clear();
+        sortKeys.reserve(visibleObjects.size());
+        for (uint32_t i = 0; i < visibleObjects.size(); ++i)
+        {
+            Object *obj = visibleObjects[i].object;
+
+            int layer = std::clamp(obj->GetLayerOrder(), -32768, 32767) + 32768;
+            int32_t y = static_cast<int32_t>(std::floor(obj->GetWorldPosition().y));
+            uint32_t sortableY = static_cast<uint32_t>(y) ^ 0x80000000u;
+
+            uint16_t textureId = 0;
+            if (SDL_Texture *tex = obj->GetRenderTexture())
+            {
+                auto it = textureIds.emplace(tex, static_cast<uint16_t>(textureIds.size() + 1)).first;
+                textureId = it->second;
+            }
+
+            uint64_t key = (static_cast<uint64_t>(layer) << 48) |
+                           (static_cast<uint64_t>(sortableY) << 16) |
+                           textureId;
+            sortKeys.push_back({key, i});
+        }
+        Sort::RadixSort64(sortKeys, sortScratch);
+
+        lastSortTime = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+
+        for (const Sort::KeyIndex &item : sortKeys)
+        {
+            const VisibleObject &visible = visibleObjects[item.index];
+            visible.object->Render(renderer, visible.givenPosition);
+        }
+    }
+
+    const RenderQueue *GetRenderQueue(int index) const
     {
-        return a->GetLayerOrder() > b->GetLayerOrder();
+        auto it = partitions.find(index);
+        return it != partitions.end() ? &it->second.renderQueue : nullptr;
     }
 };
\ No newline at end of file
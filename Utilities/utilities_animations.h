@@ -6,36 +6,28 @@
 #include <vector>
 #include <memory>
 #include <initializer_list>
+#include <unordered_map>
 #include <cmath>
+#include <utilities_textures.h>
+#include <utilities_atlas.h>
 
-struct AnimationEntry
+/**
+ * Clip d'animation immuable (frames, pattern, durée), partagé par toutes les instances
+ */
+struct AnimationClip
 {
-    std::string id, mainPath;
+    std::string id;
     float frameDuration;
-    std::vector<SDL_Texture *> frames;
+    std::vector<SpriteFrame> frames;
     std::vector<int> pattern;
-    size_t patternPos = 0;
-    float timer = 0.0f;
     float entryTime;
 
-    AnimationEntry(SDL_Renderer *renderer,
-                   std::string id_,
-                   std::string mainPath_,
-                   const std::vector<std::string> &paths,
-                   float frameDuration_,
-                   const std::vector<int> &pattern_ = {})
-        : id(std::move(id_)), mainPath(std::move(mainPath_)), frameDuration(frameDuration_)
+    AnimationClip(std::string id_,
+                  std::vector<SpriteFrame> frames_,
+                  float frameDuration_,
+                  const std::vector<int> &pattern_ = {})
+        : id(std::move(id_)), frameDuration(frameDuration_), frames(std::move(frames_))
     {
-        frames.reserve(paths.size());
-        for (auto const &p : paths)
-        {
-            SDL_Texture *tex = IMG_LoadTexture(renderer, (std::string("Assets/") + mainPath + p).c_str());
-            if (!tex)
-            {
-                Debug::Error("IMG_LoadTexture failed for " + p + ": " + IMG_GetError());
-            }
-            frames.push_back(tex);
-        }
         if (pattern_.empty())
         {
             // pattern séquentiel 0,1,...,N-1
@@ -51,58 +43,16 @@ struct AnimationEntry
         entryTime = frameDuration * frames.size();
     }
 
-    ~AnimationEntry()
-    {
-        for (auto *tex : frames)
-        {
-            if (tex)
-                SDL_DestroyTexture(tex);
-        }
-    }
-
-    void Reset()
-    {
-        patternPos = 0;
-        timer = 0.0f;
-    }
-
-    float EntryTime() const
-    {
-        return entryTime;
-    }
-
-    SDL_Texture *Next(float deltaTime, bool loop)
+    const SpriteFrame &Frame(size_t patternPos) const
     {
-        if (frames.empty() || pattern.empty())
-            return nullptr;
-        timer += deltaTime;
-        if (timer >= frameDuration)
-        {
-            float overshoot = std::fmod(timer, frameDuration);
-            size_t steps = static_cast<size_t>((timer - overshoot) / frameDuration);
-            timer = overshoot;
-            patternPos += steps;
-            if (patternPos >= pattern.size())
-            {
-                if (loop)
-                    patternPos %= pattern.size();
-                else
-                    patternPos = pattern.size() - 1;
-            }
-        }
         int idx = pattern[patternPos];
         if (idx < 0 || idx >= static_cast<int>(frames.size()))
         {
-            Debug::Error("AnimationEntry: frame index out of range for '" + id + "'");
-            return frames.front();
+            Debug::Error("AnimationClip: frame index out of range for '" + id + "'");
+            idx = 0;
         }
         return frames[idx];
     }
-
-    bool Finished() const
-    {
-        return patternPos == pattern.size() - 1;
-    }
 };
 
 /**
@@ -134,14 +84,226 @@ struct AnimationEntryTmp
 };
 
 /**
- * Le système d’animations, avec surcharge SetEntries()
+ * Jeu de clips d'un personnage, les clips sont désignés par leur indice
+ */
+class AnimationSet
+{
+public:
+    AnimationSet(SDL_Renderer *renderer, std::string mainpath)
+        : renderer_(renderer), mainPath(std::move(mainpath))
+    {
+    }
+
+    /**
+     * @param packed  range toutes les frames du jeu dans un atlas (sprites de personnages),
+     *                sinon chaque frame garde sa propre texture (images plein écran)
+     */
+    AnimationSet(SDL_Renderer *renderer, std::string mainpath, const std::vector<AnimationEntryTmp> &list, bool packed = false)
+        : AnimationSet(renderer, std::move(mainpath))
+    {
+        clips_.reserve(list.size());
+        if (!packed)
+        {
+            for (auto const &tmp : list)
+            {
+                Add(tmp.id, tmp.paths, tmp.frameDuration, tmp.pattern);
+            }
+            return;
+        }
+
+        std::vector<SpriteFrame> frames = Atlas::Pack(renderer_, mainPath, AtlasPaths(mainPath, list));
+
+        size_t first = 0;
+        for (auto const &tmp : list)
+        {
+            std::vector<SpriteFrame> clipFrames(frames.begin() + first, frames.begin() + first + tmp.paths.size());
+            first += tmp.paths.size();
+            clips_.emplace_back(tmp.id, std::move(clipFrames), tmp.frameDuration, tmp.pattern);
+        }
+    }
+
+    // chemins des frames rangées dans l'atlas, dans l'ordre des clips (à précharger avec l'AssetLoader)
+    static std::vector<std::string> AtlasPaths(const std::string &mainPath, const std::vector<AnimationEntryTmp> &list)
+    {
+        std::vector<std::string> paths;
+        for (auto const &tmp : list)
+        {
+            for (auto const &p : tmp.paths)
+                paths.push_back(std::string("Assets/") + mainPath + p);
+        }
+        return paths;
+    }
+
+    void Add(const std::string &id,
+             const std::vector<std::string> &paths,
+             float frameDuration,
+             const std::vector<int> &pattern = {})
+    {
+        std::vector<SpriteFrame> frames;
+        frames.reserve(paths.size());
+        for (auto const &p : paths)
+        {
+            // les frames identiques entre instances ne sont chargées qu'une fois
+            frames.push_back(Atlas::Single(renderer_, std::string("Assets/") + mainPath + p));
+        }
+        clips_.emplace_back(id, std::move(frames), frameDuration, pattern);
+    }
+
+    // -1 si le clip n'existe pas
+    int IndexOf(const std::string &id) const
+    {
+        for (size_t i = 0; i < clips_.size(); ++i)
+        {
+            if (clips_[i].id == id)
+                return static_cast<int>(i);
+        }
+        Debug::Error("AnimationSet: animation '" + id + "' not found in " + mainPath);
+        return -1;
+    }
+
+    const AnimationClip &operator[](int index) const
+    {
+        return clips_[index];
+    }
+
+    int Size() const
+    {
+        return static_cast<int>(clips_.size());
+    }
+
+private:
+    SDL_Renderer *renderer_;
+    std::string mainPath;
+    std::vector<AnimationClip> clips_;
+};
+
+/**
+ * Partage les jeux de clips entre les instances d'un même personnage (clé : dossier des sprites)
+ */
+class AnimationLibrary
+{
+public:
+    static AnimationLibrary &Instance()
+    {
+        static AnimationLibrary instance;
+        return instance;
+    }
+
+    std::shared_ptr<const AnimationSet> Load(SDL_Renderer *renderer,
+                                             const std::string &mainPath,
+                                             const std::vector<AnimationEntryTmp> &list)
+    {
+        auto it = sets.find(mainPath);
+        if (it != sets.end())
+        {
+            if (auto set = it->second.lock())
+                return set;
+        }
+        auto set = std::make_shared<const AnimationSet>(renderer, mainPath, list, true);
+        sets[mainPath] = set;
+        return set;
+    }
+
+private:
+    std::unordered_map<std::string, std::weak_ptr<const AnimationSet>> sets;
+};
+
+/**
+ * État de lecture propre à une instance : quelques octets, stockés à la suite dans un ComponentPool
+ */
+struct AnimationPlayer
+{
+    std::shared_ptr<const AnimationSet> set;
+    int clip = -1;
+    size_t patternPos = 0;
+    float timer = 0.0f;
+    bool loop = true;
+
+    // ne redémarre pas le clip s'il est déjà joué
+    void Play(int clipIndex, bool loop_ = true)
+    {
+        if (clip == clipIndex)
+        {
+            loop = loop_;
+            return;
+        }
+        if (!set || clipIndex < 0 || clipIndex >= set->Size())
+            return;
+        clip = clipIndex;
+        loop = loop_;
+        Reset();
+    }
+
+    void Reset()
+    {
+        patternPos = 0;
+        timer = 0.0f;
+    }
+
+    void Advance(float deltaTime)
+    {
+        if (clip < 0)
+            return;
+        const AnimationClip &c = (*set)[clip];
+        if (c.pattern.empty())
+            return;
+        timer += deltaTime;
+        if (timer >= c.frameDuration)
+        {
+            float overshoot = std::fmod(timer, c.frameDuration);
+            size_t steps = static_cast<size_t>((timer - overshoot) / c.frameDuration);
+            timer = overshoot;
+            patternPos += steps;
+            if (patternPos >= c.pattern.size())
+            {
+                if (loop)
+                    patternPos %= c.pattern.size();
+                else
+                    patternPos = c.pattern.size() - 1;
+            }
+        }
+    }
+
+    const SpriteFrame *CurrentFrame() const
+    {
+        if (clip < 0 || (*set)[clip].pattern.empty())
+            return nullptr;
+        return &(*set)[clip].Frame(patternPos);
+    }
+
+    SDL_Texture *Current() const
+    {
+        const SpriteFrame *frame = CurrentFrame();
+        return frame ? frame->Sdl() : nullptr;
+    }
+
+    bool Finished() const
+    {
+        return clip >= 0 && patternPos == (*set)[clip].pattern.size() - 1;
+    }
+
+    float EntryTime() const
+    {
+        return clip >= 0 ? (*set)[clip].entryTime : 0.0f;
+    }
+
+    const std::string &CurrentId() const
+    {
+        static std::string empty;
+        return clip >= 0 ? (*set)[clip].id : empty;
+    }
+};
+
+/**
+ * Le système d’animations des objets uniques (menus, cinématiques, niveaux) : un jeu de clips et son lecteur
  */
 class AnimationSystem
 {
 public:
     AnimationSystem(SDL_Renderer *renderer, std::string mainpath)
-        : renderer_(renderer), currentEntry_(nullptr), loop_(true), mainPath(mainpath)
+        : set_(std::make_shared<AnimationSet>(renderer, mainpath)), renderer_(renderer), mainPath(mainpath)
     {
+        player_.set = set_;
     }
 
     // ancienne méthode conservée si besoin
@@ -150,91 +312,72 @@ public:
                       float frameDuration,
                       const std::vector<int> &pattern = {})
     {
-        entries_.emplace_back(
-            std::make_unique<AnimationEntry>(renderer_, id, mainPath, paths, frameDuration, pattern));
+        set_->Add(id, paths, frameDuration, pattern);
     }
 
     // *** nouvelle surcharge ***
     void SetEntries(std::initializer_list<AnimationEntryTmp> list)
     {
-        entries_.clear();
-        currentEntry_ = nullptr;
-        for (auto const &tmp : list)
-        {
-            entries_.emplace_back(
-                std::make_unique<AnimationEntry>(
-                    renderer_,
-                    tmp.id,
-                    mainPath,
-                    tmp.paths,
-                    tmp.frameDuration,
-                    tmp.pattern));
-        }
+        set_ = std::make_shared<AnimationSet>(renderer_, mainPath, list);
+        player_ = AnimationPlayer();
+        player_.set = set_;
     }
 
     bool SetAnimation(const std::string &id, bool loop = true)
     {
-        if (currentEntry_ && currentEntry_->id == id)
+        if (player_.CurrentId() == id)
         {
-            loop_ = loop;
+            player_.loop = loop;
             return true;
         }
-        for (auto &e : entries_)
-        {
-            if (e->id == id)
-            {
-                currentEntry_ = e.get();
-                currentEntry_->Reset();
-                loop_ = loop;
-                return true;
-            }
-        }
-        Debug::Error("AnimationSystem: animation '" + id + "' not found");
-        return false;
+        int index = set_->IndexOf(id);
+        if (index < 0)
+            return false;
+        player_.Play(index, loop);
+        return true;
     }
 
     SDL_Texture *Next(float deltaTime)
     {
-        if (!currentEntry_)
-            return nullptr;
-        return currentEntry_->Next(deltaTime, loop_);
+        player_.Advance(deltaTime);
+        return player_.Current();
+    }
+
+    // comme Next, avec la région et la taille de la frame
+    const SpriteFrame *NextFrame(float deltaTime)
+    {
+        player_.Advance(deltaTime);
+        return player_.CurrentFrame();
     }
 
     void ResetAnimation()
     {
-        if (!currentEntry_)
-            return;
-        return currentEntry_->Reset();
+        player_.Reset();
     }
 
     bool Finished() const
     {
-        if (!currentEntry_)
-            return false;
-        return currentEntry_->Finished();
+        return player_.Finished();
     }
 
     float EntryTime() const
     {
-        if (!currentEntry_) return 0.0f;
-        return currentEntry_->EntryTime();
+        return player_.EntryTime();
     }
 
     // accès à l’ID ou à la texture courante si besoin
     const std::string &CurrentId() const
     {
-        static std::string empty;
-        return currentEntry_ ? currentEntry_->id : empty;
+        return player_.CurrentId();
     }
     SDL_Texture *Current() const
     {
-        return currentEntry_ ? currentEntry_->frames[currentEntry_->pattern[currentEntry_->patternPos]] : nullptr;
+        return player_.Current();
     }
 
 private:
+    std::shared_ptr<AnimationSet> set_;
+    AnimationPlayer player_;
     SDL_Renderer *renderer_;
-    std::vector<std::unique_ptr<AnimationEntry>> entries_;
-    AnimationEntry *currentEntry_;
-    bool loop_;
     std::string mainPath;
 };
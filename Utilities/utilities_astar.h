@@ -5,6 +5,9 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <SDL2/SDL.h>
 
 namespace Astar
 {
@@ -31,10 +34,296 @@ namespace Astar
         return std::abs(x1 - x2) + std::abs(y1 - y2);
     }
 
+    /**
+     * Dégagement de chaque case (indice y * largeur + x) : distance en cases jusqu'au mur le plus proche,
+     * diagonales comprises (0 sur un mur, 1 contre un mur), plafonnée à 255.
+     * level_compiler.py fait le même calcul pour les niveaux précompilés.
+     */
+    static std::vector<uint8_t> BuildClearance(const Grid &grid)
+    {
+        int H = (int)grid.size();
+        int W = H ? (int)grid[0].size() : 0;
+        std::vector<uint8_t> clearance(W * H);
+        for (int y = 0; y < H; ++y)
+            for (int x = 0; x < W; ++x)
+                clearance[y * W + x] = grid[y][x] ? 0 : 255;
+
+        auto relax = [&](int x, int y, int nx, int ny)
+        {
+            if (nx < 0 || ny < 0 || nx >= W || ny >= H)
+                return;
+            int d = clearance[ny * W + nx] + 1;
+            if (d < clearance[y * W + x])
+                clearance[y * W + x] = (uint8_t)d;
+        };
+
+        // deux passes (haut-gauche puis bas-droite) suffisent pour une distance en 8-voisinage
+        for (int y = 0; y < H; ++y)
+            for (int x = 0; x < W; ++x)
+            {
+                relax(x, y, x - 1, y);
+                relax(x, y, x - 1, y - 1);
+                relax(x, y, x, y - 1);
+                relax(x, y, x + 1, y - 1);
+            }
+        for (int y = H - 1; y >= 0; --y)
+            for (int x = W - 1; x >= 0; --x)
+            {
+                relax(x, y, x + 1, y);
+                relax(x, y, x + 1, y + 1);
+                relax(x, y, x, y + 1);
+                relax(x, y, x - 1, y + 1);
+            }
+        return clearance;
+    }
+
+    /**
+     * Recalcule le dégagement des cases à moins de NAV_REPAIR_RADIUS de la zone [x0, x1[ x [y0, y1[ après un changement
+     * de la grille. Les valeurs ne sont exactes que jusqu'à NAV_REPAIR_RADIUS : au-delà elles restent au moins égales
+     * au rayon, ce qui suffit aux comparaisons avec un minClearance plus petit.
+     */
+    static_assert(ENEMY_PATH_CLEARANCE <= NAV_REPAIR_RADIUS, "le dégagement réparé doit couvrir celui demandé aux chemins");
+
+    inline void RepairClearance(const Grid &grid, std::vector<uint8_t> &clearance, int x0, int y0, int x1, int y1)
+    {
+        int H = (int)grid.size();
+        int W = H ? (int)grid[0].size() : 0;
+        constexpr int R = NAV_REPAIR_RADIUS;
+        int wx0 = std::max(0, x0 - R), wy0 = std::max(0, y0 - R);
+        int wx1 = std::min(W, x1 + R), wy1 = std::min(H, y1 + R);
+
+        for (int y = wy0; y < wy1; ++y)
+            for (int x = wx0; x < wx1; ++x)
+            {
+                // anneaux de plus en plus larges jusqu'au premier mur
+                int found = R;
+                for (int d = 0; d < R && found == R; ++d)
+                {
+                    for (int ny = std::max(0, y - d); ny <= std::min(H - 1, y + d) && found == R; ++ny)
+                    {
+                        int step = (ny == y - d || ny == y + d) ? 1 : 2 * d;
+                        for (int nx = x - d; nx <= x + d; nx += std::max(step, 1))
+                        {
+                            if (nx >= 0 && nx < W && grid[ny][nx])
+                            {
+                                found = d;
+                                break;
+                            }
+                        }
+                    }
+                }
+                clearance[y * W + x] = (uint8_t)found;
+            }
+    }
+
+    // état de la navigation publié par NavGrid, jamais modifié ensuite
+    struct NavSnapshot
+    {
+        Grid grid;
+        std::vector<uint8_t> clearance;
+        uint32_t version = 0;
+        int originX = 0, originY = 0; // case globale de l'indice (0, 0)
+        SDL_Rect dirty{0, 0, 0, 0};   // indices changés depuis la version précédente
+    };
+
+    using NavHandle = std::shared_ptr<const NavSnapshot>;
+
+    /**
+     * Grille de navigation d'un niveau : murs fixes plus obstacles posés en jeu (plusieurs peuvent se chevaucher).
+     * Les zones passées à Block, Unblock, Move et PaintWalls sont en cases globales (la case g couvre
+     * [g, g + 1[ x LEVEL_SIZE_FACTOR dans le repère du niveau) ; la grille n'en couvre qu'une fenêtre, placée par Reset.
+     * Le thread principal modifie sa propre copie, répare le dégagement autour des cases touchées puis publie
+     * un nouvel instantané : une recherche de chemin lancée en arrière-plan garde le sien et voit toujours
+     * une grille cohérente, sans verrou.
+     */
+    class NavGrid
+    {
+    public:
+        // murs fixes de la fenêtre dont (originX, originY) est la première case ; les obstacles posés sont conservés
+        void Reset(Grid grid, std::vector<uint8_t> clear, int originX, int originY)
+        {
+            walls = std::move(grid);
+            originCellX = originX;
+            originCellY = originY;
+            int H = (int)walls.size();
+            int W = H ? (int)walls[0].size() : 0;
+            blockers.assign(W * H, 0);
+
+            cells = walls;
+            for (const SDL_Rect &area : blockedAreas)
+                Change(area, +1);
+            clearance = blockedAreas.empty() && clear.size() == size_t(W * H) ? std::move(clear) : BuildClearance(cells);
+            Publish({0, 0, W, H});
+        }
+
+        void Block(const SDL_Rect &area)
+        {
+            blockedAreas.push_back(area);
+            Repair(Change(area, +1));
+        }
+
+        void Unblock(const SDL_Rect &area)
+        {
+            auto it = std::find_if(blockedAreas.begin(), blockedAreas.end(), [&](const SDL_Rect &r)
+            {
+                return SDL_RectEquals(&r, &area);
+            });
+            if (it == blockedAreas.end())
+                return;
+            blockedAreas.erase(it);
+            Repair(Change(area, -1));
+        }
+
+        // déplacement d'un obstacle : une seule réparation et une seule version pour les deux zones
+        void Move(const SDL_Rect &from, const SDL_Rect &to)
+        {
+            auto it = std::find_if(blockedAreas.begin(), blockedAreas.end(), [&](const SDL_Rect &r)
+            {
+                return SDL_RectEquals(&r, &from);
+            });
+            if (it == blockedAreas.end())
+                return;
+            *it = to;
+
+            SDL_Rect a = Change(from, -1), b = Change(to, +1), dirty;
+            if (SDL_RectEmpty(&a))
+                dirty = b;
+            else if (SDL_RectEmpty(&b))
+                dirty = a;
+            else
+                SDL_UnionRect(&a, &b, &dirty);
+            Repair(dirty);
+        }
+
+        /**
+         * Remplace les murs fixes d'une zone (morceau de monde chargé ou déchargé) : src et srcClearance couvrent
+         * toute la zone, src nul la rend pleine. Le dégagement fourni est repris tel quel à l'intérieur ; seule
+         * une bande de NAV_REPAIR_RADIUS cases autour des bords, où comptent les murs voisins, est recalculée.
+         */
+        void PaintWalls(const SDL_Rect &area, const Grid *src, const std::vector<uint8_t> *srcClearance)
+        {
+            int H = (int)cells.size();
+            int W = H ? (int)cells[0].size() : 0;
+            SDL_Rect local{area.x - originCellX, area.y - originCellY, area.w, area.h}, bounds{0, 0, W, H}, clipped;
+            if (!SDL_IntersectRect(&local, &bounds, &clipped))
+                return;
+
+            for (int y = clipped.y; y < clipped.y + clipped.h; ++y)
+                for (int x = clipped.x; x < clipped.x + clipped.w; ++x)
+                {
+                    int sx = x - local.x, sy = y - local.y;
+                    walls[y][x] = src ? (*src)[sy][sx] : true;
+                    cells[y][x] = walls[y][x] || blockers[y * W + x] > 0;
+                    clearance[y * W + x] = !src ? 0 : srcClearance ? (*srcClearance)[sy * area.w + sx] : 0;
+                }
+
+            if (src && !srcClearance)
+            {
+                RepairClearance(cells, clearance, clipped.x, clipped.y, clipped.x + clipped.w, clipped.y + clipped.h);
+            }
+            else
+            {
+                int x0 = clipped.x, y0 = clipped.y, x1 = clipped.x + clipped.w, y1 = clipped.y + clipped.h;
+                RepairClearance(cells, clearance, x0, y0, x1, y0 + 1);
+                RepairClearance(cells, clearance, x0, y1 - 1, x1, y1);
+                RepairClearance(cells, clearance, x0, y0, x0 + 1, y1);
+                RepairClearance(cells, clearance, x1 - 1, y0, x1, y1);
+                // obstacles posés dans la zone : le dégagement fourni les ignore
+                for (const SDL_Rect &blocked : blockedAreas)
+                {
+                    SDL_Rect b{blocked.x - originCellX, blocked.y - originCellY, blocked.w, blocked.h}, inside;
+                    if (SDL_IntersectRect(&b, &clipped, &inside))
+                        RepairClearance(cells, clearance, inside.x, inside.y, inside.x + inside.w, inside.y + inside.h);
+                }
+            }
+            Publish(clipped);
+        }
+
+        // grille courante, lue par le thread principal (collisions par cases)
+        const Grid &Cells() const
+        {
+            return cells;
+        }
+
+        int OriginX() const
+        {
+            return originCellX;
+        }
+
+        int OriginY() const
+        {
+            return originCellY;
+        }
+
+        // instantané à passer aux recherches de chemin en arrière-plan
+        NavHandle Snapshot() const
+        {
+            return snapshot;
+        }
+
+        uint32_t Version() const
+        {
+            return version;
+        }
+
+    private:
+        Grid walls, cells;
+        std::vector<uint8_t> clearance;
+        std::vector<uint16_t> blockers;     // obstacles par case de la fenêtre
+        std::vector<SDL_Rect> blockedAreas; // zones des obstacles, en cases globales, pour replacer la fenêtre
+        NavHandle snapshot;
+        uint32_t version = 0;
+        int originCellX = 0, originCellY = 0;
+
+        // indices effectivement modifiés, limités à la fenêtre
+        SDL_Rect Change(const SDL_Rect &area, int delta)
+        {
+            int H = (int)cells.size();
+            int W = H ? (int)cells[0].size() : 0;
+            SDL_Rect local{area.x - originCellX, area.y - originCellY, area.w, area.h}, bounds{0, 0, W, H}, clipped;
+            if (!SDL_IntersectRect(&local, &bounds, &clipped))
+                return {0, 0, 0, 0};
+
+            for (int y = clipped.y; y < clipped.y + clipped.h; ++y)
+                for (int x = clipped.x; x < clipped.x + clipped.w; ++x)
+                {
+                    uint16_t &count = blockers[y * W + x];
+                    count = delta > 0 ? count + 1 : (count > 0 ? count - 1 : 0);
+                    cells[y][x] = walls[y][x] || count > 0;
+                }
+            return clipped;
+        }
+
+        void Repair(const SDL_Rect &dirty)
+        {
+            if (SDL_RectEmpty(&dirty))
+                return;
+            RepairClearance(cells, clearance, dirty.x, dirty.y, dirty.x + dirty.w, dirty.y + dirty.h);
+            Publish(dirty);
+        }
+
+        void Publish(const SDL_Rect &dirty)
+        {
+            auto next = std::make_shared<NavSnapshot>();
+            next->grid = cells;
+            next->clearance = clearance;
+            next->version = ++version;
+            next->originX = originCellX;
+            next->originY = originCellY;
+            next->dirty = dirty;
+            snapshot = std::move(next);
+        }
+    };
+
+    /**
+     * Avec un dégagement, les cases à moins de minClearance d'un mur sont évitées (sauf le départ et l'arrivée).
+     */
     static std::vector<Vector2D> AStar(
         const Grid &grid,
         const Vector2D startPos,
-        const Vector2D goalPos)
+        const Vector2D goalPos,
+        const std::vector<uint8_t> *clearance = nullptr,
+        int minClearance = 0)
     {
         int H = (int)grid.size();
         int W = H ? (int)grid[0].size() : 0;
@@ -95,6 +384,8 @@ namespace Astar
                 int ny = current->y + dy[i];
                 if (!inBounds(nx, ny) || grid[ny][nx] || closed[ny][nx])
                     continue;
+                if (clearance && (*clearance)[ny * W + nx] < minClearance && !(nx == gx && ny == gy))
+                    continue;
 
                 ANode *neighbor = &nodes[ny][nx];
                 float tentative_g = current->g + 1.0f;
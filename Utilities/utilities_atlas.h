@@ -0,0 +1,294 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+
+/**
+ * Région d'une texture : une image seule (src couvre toute la texture) ou une case d'atlas
+ */
+struct SpriteFrame
+{
+    TextureHandle texture;
+    SDL_Rect src{0, 0, 0, 0};
+
+    SDL_Texture *Sdl() const
+    {
+        return texture ? texture->sdl : nullptr;
+    }
+};
+
+/**
+ * Rangement par étagères : les rectangles sont posés de gauche à droite,
+ * une nouvelle étagère est ouverte quand la ligne est pleine.
+ */
+class ShelfPacker
+{
+public:
+    ShelfPacker(int width_, int height_) : width(width_), height(height_) {}
+
+    bool Insert(int w, int h, SDL_Rect &out)
+    {
+        if (w > width)
+            return false;
+        if (cursorX + w > width)
+        {
+            shelfY += shelfHeight;
+            cursorX = 0;
+            shelfHeight = 0;
+        }
+        if (shelfY + h > height)
+            return false;
+
+        out = {cursorX, shelfY, w, h};
+        cursorX += w;
+        shelfHeight = std::max(shelfHeight, h);
+        return true;
+    }
+
+    // hauteur réellement occupée, pour ne pas allouer une page plus grande que nécessaire
+    int UsedHeight() const
+    {
+        return shelfY + shelfHeight;
+    }
+
+private:
+    int width, height;
+    int cursorX = 0, shelfY = 0, shelfHeight = 0;
+};
+
+namespace Atlas
+{
+    static constexpr int MAX_PAGE_SIZE = 4096;
+    static constexpr int PADDING = 2; // évite que le filtrage ne déborde sur la case voisine
+
+    // case occupée par une image dans une page d'atlas encore en mémoire, pour Reload
+    struct Region
+    {
+        std::weak_ptr<Texture> page;
+        SDL_Rect rect;
+    };
+
+    inline std::unordered_map<std::string, std::vector<Region>> &Regions()
+    {
+        static std::unordered_map<std::string, std::vector<Region>> regions;
+        return regions;
+    }
+
+    inline void ForgetExpired(std::vector<Region> &regions)
+    {
+        regions.erase(std::remove_if(regions.begin(), regions.end(), [](const Region &region)
+        {
+            return region.page.expired();
+        }), regions.end());
+    }
+
+    /**
+     * Charge les images et les range dans une ou plusieurs pages d'atlas.
+     * Les frames sont renvoyées dans l'ordre des chemins, un même chemin n'est stocké qu'une fois.
+     *
+     * @param name   nom de l'atlas, sert de clé dans le TextureCache
+     * @param paths  chemins depuis le dossier du jeu
+     */
+    inline std::vector<SpriteFrame> Pack(SDL_Renderer *renderer, const std::string &name, const std::vector<std::string> &paths)
+    {
+        std::vector<SpriteFrame> frames(paths.size());
+
+        // images distinctes
+        std::unordered_map<std::string, size_t> uniqueIndex;
+        std::vector<std::string> uniquePaths;
+        std::vector<size_t> frameToUnique(paths.size());
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            auto it = uniqueIndex.emplace(paths[i], uniquePaths.size()).first;
+            if (it->second == uniquePaths.size())
+                uniquePaths.push_back(paths[i]);
+            frameToUnique[i] = it->second;
+        }
+
+        std::vector<SDL_Surface *> surfaces(uniquePaths.size(), nullptr);
+        for (size_t i = 0; i < uniquePaths.size(); ++i)
+        {
+            // déjà décodée par l'AssetLoader si l'image fait partie d'un bundle
+            surfaces[i] = AssetLoader::Instance().TakeSurface(uniquePaths[i]);
+            if (!surfaces[i])
+            {
+                SDL_Surface *surf = IMG_Load_RW(AssetPack::Instance().OpenRW(uniquePaths[i]), 1);
+                if (!surf)
+                {
+                    Debug::Error("Atlas: IMG_Load failed for " + uniquePaths[i] + ": " + IMG_GetError());
+                    continue;
+                }
+                surfaces[i] = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
+                SDL_FreeSurface(surf);
+            }
+            if (surfaces[i])
+                SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+        }
+
+        SDL_RendererInfo info;
+        int pageSize = MAX_PAGE_SIZE;
+        if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0)
+        {
+            pageSize = std::min({pageSize, info.max_texture_width, info.max_texture_height});
+        }
+
+        // les plus hautes d'abord : les étagères sont mieux remplies
+        std::vector<size_t> order(uniquePaths.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            int ha = surfaces[a] ? surfaces[a]->h : 0;
+            int hb = surfaces[b] ? surfaces[b]->h : 0;
+            return ha > hb;
+        });
+
+        std::vector<int> page(uniquePaths.size(), -1);
+        std::vector<SDL_Rect> rects(uniquePaths.size());
+        std::vector<ShelfPacker> packers;
+        for (size_t i : order)
+        {
+            SDL_Surface *surf = surfaces[i];
+            if (!surf)
+                continue;
+            int w = surf->w + PADDING, h = surf->h + PADDING;
+            if (w > pageSize || h > pageSize)
+            {
+                Debug::Error("Atlas: " + uniquePaths[i] + " is larger than an atlas page");
+                continue;
+            }
+
+            SDL_Rect r;
+            if (packers.empty() || !packers.back().Insert(w, h, r))
+            {
+                packers.emplace_back(pageSize, pageSize);
+                packers.back().Insert(w, h, r);
+            }
+            page[i] = static_cast<int>(packers.size() - 1);
+            rects[i] = {r.x, r.y, surf->w, surf->h};
+        }
+
+        std::vector<TextureHandle> pages(packers.size());
+        for (size_t p = 0; p < packers.size(); ++p)
+        {
+            SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, pageSize, packers[p].UsedHeight(), 32, SDL_PIXELFORMAT_RGBA32);
+            if (!atlas)
+            {
+                Debug::Error("Atlas: SDL_CreateRGBSurfaceWithFormat failed: " + std::string(SDL_GetError()));
+                continue;
+            }
+            SDL_FillRect(atlas, nullptr, 0);
+            for (size_t i = 0; i < uniquePaths.size(); ++i)
+            {
+                if (page[i] == static_cast<int>(p))
+                {
+                    SDL_Rect dst = rects[i];
+                    SDL_BlitSurface(surfaces[i], nullptr, atlas, &dst);
+                }
+            }
+
+            SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, atlas);
+            SDL_FreeSurface(atlas);
+            if (!tex)
+            {
+                Debug::Error("Atlas: SDL_CreateTextureFromSurface failed: " + std::string(SDL_GetError()));
+                continue;
+            }
+            pages[p] = TextureCache::Instance().Insert("atlas:" + name + "#" + std::to_string(p), tex);
+        }
+
+        for (SDL_Surface *surf : surfaces)
+        {
+            if (surf)
+                SDL_FreeSurface(surf);
+        }
+
+        for (size_t i = 0; i < uniquePaths.size(); ++i)
+        {
+            if (page[i] >= 0 && pages[page[i]])
+            {
+                std::vector<Region> &regions = Regions()[uniquePaths[i]];
+                ForgetExpired(regions);
+                regions.push_back({pages[page[i]], rects[i]});
+            }
+        }
+
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            size_t u = frameToUnique[i];
+            if (page[u] >= 0)
+            {
+                frames[i].texture = pages[page[u]];
+                frames[i].src = rects[u];
+            }
+        }
+
+        Debug::Log("Atlas '" + name + "': " + std::to_string(uniquePaths.size()) + " images in " +
+                   std::to_string(pages.size()) + " page(s)");
+        return frames;
+    }
+
+    /**
+     * Réécrit une image modifiée sur le disque dans toutes les pages d'atlas qui la contiennent (rechargement à chaud).
+     * Faux si l'image n'est dans aucun atlas en mémoire. Une image qui a changé de taille ne tient plus dans sa case :
+     * elle n'est pas reprise, il faut relancer le jeu.
+     */
+    inline bool Reload(const std::string &path)
+    {
+        auto it = Regions().find(path);
+        if (it == Regions().end())
+            return false;
+        ForgetExpired(it->second);
+        if (it->second.empty())
+        {
+            Regions().erase(it);
+            return false;
+        }
+
+        SDL_Surface *surf = IMG_Load_RW(AssetPack::Instance().OpenRW(path), 1);
+        if (!surf)
+        {
+            Debug::Error("Atlas: reload failed for " + path + ": " + IMG_GetError());
+            return true;
+        }
+
+        for (const Region &region : it->second)
+        {
+            TextureHandle page = region.page.lock();
+            if (surf->w != region.rect.w || surf->h != region.rect.h)
+            {
+                Debug::Error("Atlas: " + path + " changed size, restart to repack it");
+                break;
+            }
+
+            // les pixels envoyés doivent être au format de la page, choisi par le renderer
+            Uint32 format = 0;
+            SDL_QueryTexture(page->sdl, &format, nullptr, nullptr, nullptr);
+            SDL_Surface *converted = SDL_ConvertSurfaceFormat(surf, format, 0);
+            if (!converted)
+            {
+                Debug::Error("Atlas: SDL_ConvertSurfaceFormat failed: " + std::string(SDL_GetError()));
+                break;
+            }
+            SDL_UpdateTexture(page->sdl, &region.rect, converted->pixels, converted->pitch);
+            SDL_FreeSurface(converted);
+        }
+        SDL_FreeSurface(surf);
+        return true;
+    }
+
+    // image seule, sans atlas (cinématiques, fonds de niveau)
+    inline SpriteFrame Single(SDL_Renderer *renderer, const std::string &path)
+    {
+        SpriteFrame frame;
+        frame.texture = TextureCache::Instance().Load(renderer, path);
+        if (frame.texture)
+            frame.src = {0, 0, frame.texture->width, frame.texture->height};
+        return frame;
+    }
+}
@@ -19,6 +19,9 @@ public:
     // path: file path to load the sound from (relative to Assets/Sounds/)
     bool RegisterSound(const std::string &id, const std::string &path);
 
+    // register an already loaded sound (see AssetLoader); the manager takes ownership of chunk
+    bool RegisterChunk(const std::string &id, Mix_Chunk *chunk);
+
     // unregister a sound
     // id: unique identifier of the sound to remove
     void UnregisterSound(const std::string &id);
@@ -75,12 +78,23 @@ inline bool SoundManager::RegisterSound(const std::string &id, const std::string
         return false;
     }
     std::string p = std::string("Assets/Sounds/") + path;
-    Mix_Chunk *chunk = Mix_LoadWAV(p.c_str());
+    Mix_Chunk *chunk = Mix_LoadWAV_RW(AssetPack::Instance().OpenRW(p), 1);
     if (!chunk)
     {
         Debug::Error("RegisterSound: Failed to load sound " + p + ": " + Mix_GetError());
         return false;
     }
+    return RegisterChunk(id, chunk);
+}
+
+inline bool SoundManager::RegisterChunk(const std::string &id, Mix_Chunk *chunk)
+{
+    if (m_Sounds.count(id))
+    {
+        Debug::Error("RegisterChunk: ID already exists: " + id);
+        Mix_FreeChunk(chunk);
+        return false;
+    }
     m_Sounds[id] = chunk;
     Debug::Log("RegisterSound: Sound registered with ID " + id);
     return true;
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <cmath>
+
+/**
+ * Regroupe les sprites (quads tournés) et les rectangles de couleur d'une même texture
+ * dans un tampon de sommets, envoyé en un seul SDL_RenderGeometry.
+ * L'ordre d'affichage est conservé : le tampon est vidé dès que la texture change.
+ */
+class SpriteBatch
+{
+public:
+    static SpriteBatch &Instance()
+    {
+        static SpriteBatch instance;
+        return instance;
+    }
+
+    /**
+     * @param src    région de la texture (taille texW x texH)
+     * @param dst    rectangle à l'écran, avant rotation
+     * @param angle  rotation en degrés autour du centre de dst, sens horaire comme SDL_RenderCopyEx
+     * @param color  teinte et opacité appliquées aux sommets
+     */
+    void Draw(SDL_Renderer *renderer, SDL_Texture *texture, int texW, int texH,
+              const SDL_Rect &src, const SDL_FRect &dst, float angle = 0.0f, SDL_Color color = {255, 255, 255, 255})
+    {
+        if (!texture || texW <= 0 || texH <= 0)
+            return;
+
+        float u0 = static_cast<float>(src.x) / texW;
+        float v0 = static_cast<float>(src.y) / texH;
+        float u1 = static_cast<float>(src.x + src.w) / texW;
+        float v1 = static_cast<float>(src.y + src.h) / texH;
+
+        PushQuad(renderer, texture, dst, angle, color, u0, v0, u1, v1);
+    }
+
+    void Draw(SDL_Renderer *renderer, const SpriteFrame &frame, const SDL_FRect &dst,
+              float angle = 0.0f, SDL_Color color = {255, 255, 255, 255})
+    {
+        if (!frame.texture)
+            return;
+        Draw(renderer, frame.texture->sdl, frame.texture->width, frame.texture->height, frame.src, dst, angle, color);
+    }
+
+    // rectangle plein, sans texture : tous les rectangles consécutifs partagent un appel
+    void FillRect(SDL_Renderer *renderer, const SDL_FRect &rect, SDL_Color color)
+    {
+        PushQuad(renderer, nullptr, rect, 0.0f, color, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    // envoie les sommets en attente ; à appeler avant tout rendu qui ne passe pas par le batch
+    void Flush()
+    {
+        if (vertices.empty())
+            return;
+
+        size_t quads = vertices.size() / 4;
+        EnsureIndices(quads);
+        SDL_RenderGeometry(currentRenderer, currentTexture,
+                           vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(quads * 6));
+        ++drawCalls;
+        vertices.clear();
+    }
+
+    // statistiques de la frame écoulée, puis remise à zéro
+    void EndFrame()
+    {
+        Flush();
+        lastDrawCalls = drawCalls;
+        lastQuads = quadCount;
+        drawCalls = 0;
+        quadCount = 0;
+    }
+
+    int GetDrawCalls() const
+    {
+        return lastDrawCalls;
+    }
+
+    int GetQuadCount() const
+    {
+        return lastQuads;
+    }
+
+private:
+    SpriteBatch() = default;
+
+    void PushQuad(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect &dst, float angle, SDL_Color color,
+                  float u0, float v0, float u1, float v1)
+    {
+        if (renderer != currentRenderer || texture != currentTexture)
+        {
+            Flush();
+            currentRenderer = renderer;
+            currentTexture = texture;
+        }
+
+        float hw = dst.w * 0.5f, hh = dst.h * 0.5f;
+        float cx = dst.x + hw, cy = dst.y + hh;
+
+        // coins relatifs au centre : haut-gauche, haut-droit, bas-droit, bas-gauche
+        float corners[4][2] = {{-hw, -hh}, {hw, -hh}, {hw, hh}, {-hw, hh}};
+        float uvs[4][2] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+        float c = 1.0f, s = 0.0f;
+        if (angle != 0.0f)
+        {
+            float rad = angle * PI / 180.0f;
+            c = std::cos(rad);
+            s = std::sin(rad);
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            SDL_Vertex v;
+            v.position.x = cx + corners[i][0] * c - corners[i][1] * s;
+            v.position.y = cy + corners[i][0] * s + corners[i][1] * c;
+            v.color = color;
+            v.tex_coord.x = uvs[i][0];
+            v.tex_coord.y = uvs[i][1];
+            vertices.push_back(v);
+        }
+        ++quadCount;
+    }
+
+    void EnsureIndices(size_t quads)
+    {
+        for (size_t q = indices.size() / 6; q < quads; ++q)
+        {
+            int base = static_cast<int>(q * 4);
+            indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+    }
+
+    SDL_Renderer *currentRenderer = nullptr;
+    SDL_Texture *currentTexture = nullptr;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    int drawCalls = 0, quadCount = 0;
+    int lastDrawCalls = 0, lastQuads = 0;
+};
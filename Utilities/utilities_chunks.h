@@ -0,0 +1,277 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <future>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+// monde découpé en morceaux carrés (voir chunk_builder.py), décrit par le manifeste des niveaux
+struct ChunkSettings
+{
+    std::string folder;                         // chunk_<x>_<y>.png et chunk_<x>_<y>.lvl, depuis le dossier du jeu
+    int cells = 100;                            // cases par côté d'un morceau
+    int minX = 0, minY = 0, maxX = 0, maxY = 0; // morceaux existants, bornes comprises
+
+    std::string Path(int x, int y, const char *extension) const
+    {
+        return folder + "chunk_" + std::to_string(x) + "_" + std::to_string(y) + extension;
+    }
+
+    bool Exists(int x, int y) const
+    {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY;
+    }
+
+    // morceau contenant un point local au niveau
+    std::pair<int, int> ChunkAt(const Vector2D &p, float cellSize) const
+    {
+        float span = cells * cellSize;
+        return {(int)std::floor(p.x / span), (int)std::floor(p.y / span)};
+    }
+
+    // images des morceaux chargés autour d'un point, à précharger avec le niveau
+    std::vector<std::string> TexturesAround(const Vector2D &focus, float cellSize) const
+    {
+        std::vector<std::string> paths;
+        auto [cx, cy] = ChunkAt(focus, cellSize);
+        for (int y = cy - CHUNK_STREAM_RADIUS; y <= cy + CHUNK_STREAM_RADIUS; ++y)
+            for (int x = cx - CHUNK_STREAM_RADIUS; x <= cx + CHUNK_STREAM_RADIUS; ++x)
+                if (Exists(x, y))
+                    paths.push_back(Path(x, y, ".png"));
+        return paths;
+    }
+};
+
+/**
+ * Morceaux d'un monde chargés autour de la caméra : image de fond et grille de chaque morceau.
+ * Les images sont décodées par l'AssetLoader et les .lvl lus par std::async, hors du thread principal.
+ * Les grilles des morceaux à CHUNK_STREAM_RADIUS du morceau central sont peintes dans une fenêtre de navigation
+ * qui suit la caméra : collisions par cases, obstacles et chemins des ennemis la traversent d'un morceau à l'autre
+ * comme une seule grille. Un morceau pas encore chargé y est plein.
+ * Les morceaux sont gardés un anneau plus loin avant d'être libérés, pour ne pas tout relire sur un aller-retour.
+ */
+class ChunkStreamer : public std::enable_shared_from_this<ChunkStreamer>
+{
+public:
+    void Init(const ChunkSettings &_settings, float _cellSize, Astar::NavGrid *_nav)
+    {
+        settings = _settings;
+        cellSize = _cellSize;
+        nav = _nav;
+    }
+
+    const ChunkSettings &Settings() const
+    {
+        return settings;
+    }
+
+    // change à chaque fond de morceau ajouté ou retiré (clé des calques mis en cache)
+    unsigned Revision() const
+    {
+        return revision;
+    }
+
+    /**
+     * Une fois par frame, point local au niveau. Change de fenêtre quand le point entre dans un autre morceau,
+     * lance les chargements manquants et peint ceux qui viennent de se terminer.
+     */
+    void Update(const Vector2D &focus)
+    {
+        auto [cx, cy] = settings.ChunkAt(focus, cellSize);
+        if (!centered || cx != centerX || cy != centerY)
+            Recenter(cx, cy);
+
+        for (auto &[key, chunk] : chunks)
+        {
+            if (chunk.loading && chunk.pending.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready)
+                Integrate(key, chunk, chunk.pending.get());
+        }
+    }
+
+    // au chargement du niveau : les morceaux autour de l'apparition sont lus tout de suite, le joueur n'arrive pas dans le plein
+    void LoadAround(const Vector2D &focus)
+    {
+        auto [cx, cy] = settings.ChunkAt(focus, cellSize);
+        for (int y = cy - CHUNK_STREAM_RADIUS; y <= cy + CHUNK_STREAM_RADIUS; ++y)
+            for (int x = cx - CHUNK_STREAM_RADIUS; x <= cx + CHUNK_STREAM_RADIUS; ++x)
+            {
+                if (!settings.Exists(x, y) || chunks.count({x, y}))
+                    continue;
+                Chunk &chunk = chunks[{x, y}];
+                // image déjà envoyée par le bundle du niveau
+                chunk.background = TextureCache::Instance().Find(settings.Path(x, y, ".png"));
+                ++revision;
+                chunk.data = Read(settings.Path(x, y, ".lvl"), settings.cells);
+            }
+        Recenter(cx, cy);
+    }
+
+    // fonds des morceaux visibles ; origin est la position à l'écran du point (0, 0) du niveau
+    void Render(SDL_Renderer *renderer, const Vector2D &origin, const Vector2D &viewport) const
+    {
+        float span = settings.cells * cellSize;
+        for (const auto &[key, chunk] : chunks)
+        {
+            const TextureHandle &tex = chunk.background;
+            if (!tex)
+                continue;
+
+            SDL_FRect dst{origin.x + key.first * span, origin.y + key.second * span, span, span};
+            if (dst.x > viewport.x || dst.y > viewport.y || dst.x + dst.w < 0 || dst.y + dst.h < 0)
+                continue;
+            SpriteBatch::Instance().Draw(renderer, tex->sdl, tex->width, tex->height, {0, 0, tex->width, tex->height}, dst);
+        }
+    }
+
+private:
+    struct ChunkData
+    {
+        Astar::Grid grid;
+        std::vector<uint8_t> clearance;
+    };
+    using ChunkHandle = std::shared_ptr<const ChunkData>;
+
+    struct Chunk
+    {
+        TextureHandle background;
+        ChunkHandle data; // nul tant que le .lvl n'est pas lu (ou s'il est invalide)
+        std::future<ChunkHandle> pending;
+        bool loading = false;
+    };
+
+    using ChunkKey = std::pair<int, int>;
+
+    ChunkSettings settings;
+    float cellSize = 1.0f;
+    Astar::NavGrid *nav = nullptr;
+    std::map<ChunkKey, Chunk> chunks;
+    int centerX = 0, centerY = 0;
+    bool centered = false;
+    unsigned int bundleCount = 0;
+    unsigned revision = 0;
+
+    // thread de chargement ou thread principal
+    static ChunkHandle Read(const std::string &path, int cells)
+    {
+        LevelFile file;
+        if (!file.Open(path))
+            return nullptr;
+        auto data = std::make_shared<ChunkData>();
+        data->grid = file.NavGrid();
+        data->clearance = file.Clearance();
+        if ((int)data->grid.size() != cells || (int)data->grid[0].size() != cells)
+            return nullptr;
+        return data;
+    }
+
+    bool InWindow(const ChunkKey &key) const
+    {
+        return std::abs(key.first - centerX) <= CHUNK_STREAM_RADIUS && std::abs(key.second - centerY) <= CHUNK_STREAM_RADIUS;
+    }
+
+    SDL_Rect Area(const ChunkKey &key) const
+    {
+        return {key.first * settings.cells, key.second * settings.cells, settings.cells, settings.cells};
+    }
+
+    void Integrate(const ChunkKey &key, Chunk &chunk, ChunkHandle data)
+    {
+        chunk.loading = false;
+        chunk.data = std::move(data);
+        if (!chunk.data)
+        {
+            Debug::Error("ChunkStreamer: cannot read " + settings.Path(key.first, key.second, ".lvl"));
+            return;
+        }
+        if (InWindow(key))
+            nav->PaintWalls(Area(key), &chunk.data->grid, &chunk.data->clearance);
+    }
+
+    void Request(const ChunkKey &key)
+    {
+        Chunk &chunk = chunks[key];
+        chunk.loading = true;
+        chunk.pending = std::async(std::launch::async, &ChunkStreamer::Read, settings.Path(key.first, key.second, ".lvl"), settings.cells);
+
+        std::string image = settings.Path(key.first, key.second, ".png");
+        if ((chunk.background = TextureCache::Instance().Find(image)))
+        {
+            ++revision;
+            return;
+        }
+
+        // le morceau peut avoir été libéré, ou le niveau détruit, avant la fin du décodage
+        std::weak_ptr<ChunkStreamer> self = weak_from_this();
+        AssetBundle bundle;
+        bundle.name = "chunk:" + image + "#" + std::to_string(++bundleCount);
+        bundle.textures = {image};
+        bundle.onReady = [self, key, image, name = bundle.name]()
+        {
+            // rien ne dépend d'un morceau : le chargeur n'a pas à s'en souvenir
+            AssetLoader::Instance().Release(name);
+            if (auto streamer = self.lock())
+            {
+                auto it = streamer->chunks.find(key);
+                if (it != streamer->chunks.end())
+                {
+                    it->second.background = TextureCache::Instance().Find(image);
+                    ++streamer->revision;
+                }
+            }
+        };
+        AssetLoader::Instance().Enqueue(std::move(bundle));
+    }
+
+    /**
+     * Nouveau morceau central : la fenêtre est reconstruite avec les grilles déjà en mémoire, les morceaux
+     * manquants sont demandés et ceux au-delà de l'anneau de garde libérés (sauf s'ils sont en cours de lecture).
+     */
+    void Recenter(int cx, int cy)
+    {
+        centerX = cx;
+        centerY = cy;
+        centered = true;
+
+        int R = CHUNK_STREAM_RADIUS, cells = settings.cells;
+        int size = (2 * R + 1) * cells;
+        Astar::Grid walls(size, std::vector<bool>(size, true));
+        for (int y = cy - R; y <= cy + R; ++y)
+            for (int x = cx - R; x <= cx + R; ++x)
+            {
+                if (!settings.Exists(x, y))
+                    continue;
+                auto it = chunks.find({x, y});
+                if (it == chunks.end())
+                {
+                    Request({x, y});
+                    continue;
+                }
+                if (!it->second.data)
+                    continue;
+
+                const Astar::Grid &grid = it->second.data->grid;
+                int ox = (x - (cx - R)) * cells, oy = (y - (cy - R)) * cells;
+                for (int j = 0; j < cells; ++j)
+                    for (int i = 0; i < cells; ++i)
+                        walls[oy + j][ox + i] = grid[j][i];
+            }
+        nav->Reset(std::move(walls), {}, (cx - R) * cells, (cy - R) * cells);
+
+        for (auto it = chunks.begin(); it != chunks.end();)
+        {
+            bool far = std::abs(it->first.first - cx) > R + 1 || std::abs(it->first.second - cy) > R + 1;
+            if (far && !it->second.loading)
+            {
+                revision += it->second.background != nullptr;
+                it = chunks.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+};
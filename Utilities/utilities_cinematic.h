@@ -0,0 +1,305 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * Lecture des cinématiques .cin produites par cinematic_converter.py : images clés et frames delta.
+ * Une frame est une suite d'opérations de type QOI (index, écart, répétition, couleur) compressée par un LZ
+ * de type LZ4, sans perte ; dans une frame delta, l'opération SKIP garde les pixels de la frame précédente.
+ * Les frames sont appliquées sur une image RGBA conservée d'un appel à l'autre,
+ * une lecture dans l'ordre ne décode donc que les pixels qui changent.
+ */
+class CinematicFile
+{
+public:
+    static constexpr uint16_t VERSION = 3;
+
+    bool Open(const std::string &path)
+    {
+        // lu directement dans l'archive projetée, sinon copié depuis le fichier libre
+        if (!AssetPack::Instance().View(path, data, dataSize))
+        {
+            if (!AssetPack::Instance().Read(path, owned))
+                return false;
+            data = reinterpret_cast<const uint8_t *>(owned.data());
+            dataSize = owned.size();
+        }
+        if (dataSize < HEADER_SIZE || std::memcmp(data, "RCIN", 4) != 0)
+        {
+            Debug::Error("CinematicFile: invalid file " + path);
+            return false;
+        }
+
+        uint16_t version = Read16(4);
+        if (version != VERSION)
+        {
+            Debug::Error("CinematicFile: unsupported version " + std::to_string(version) + " in " + path);
+            return false;
+        }
+        width = static_cast<int>(Read32(8));
+        height = static_cast<int>(Read32(12));
+        frameCount = static_cast<int>(Read32(16));
+
+        if (width <= 0 || height <= 0 || HEADER_SIZE + 4 * (static_cast<size_t>(frameCount) + 1) > dataSize)
+        {
+            Debug::Error("CinematicFile: corrupted header in " + path);
+            return false;
+        }
+        canvas.assign(static_cast<size_t>(width) * height * 4, 0);
+        decoded = -1;
+        return true;
+    }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    int FrameCount() const { return frameCount; }
+
+    /**
+     * Décode une frame en RGBA32 dans dst (pitch en octets).
+     * Avancer d'une frame ne coûte que le delta ; un retour en arrière repart de l'image clé précédente.
+     */
+    bool Decode(int frame, uint8_t *dst, int pitch)
+    {
+        if (frame < 0 || frame >= frameCount)
+            return false;
+
+        if (frame != decoded)
+        {
+            int start = decoded + 1;
+            bool keyBetween = false;
+            for (int f = start; f <= frame && !keyBetween; ++f)
+                keyBetween = IsKey(f);
+            if (decoded < 0 || frame < decoded || keyBetween)
+            {
+                start = frame;
+                while (start > 0 && !IsKey(start))
+                    --start;
+            }
+            for (int f = start; f <= frame; ++f)
+            {
+                if (!Apply(f))
+                {
+                    decoded = -1;
+                    return false;
+                }
+                decoded = f;
+            }
+        }
+
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        for (int y = 0; y < height; ++y)
+            std::memcpy(dst + static_cast<size_t>(y) * pitch, canvas.data() + y * rowBytes, rowBytes);
+        return true;
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE = 24;
+    static constexpr uint8_t FRAME_DELTA = 1; // opérations appliquées sur la frame précédente
+    static constexpr uint8_t OP_SKIP = 0xFC;
+    static constexpr uint8_t OP_RGB = 0xFE;
+    static constexpr uint8_t OP_RGBA = 0xFF;
+
+    uint16_t Read16(size_t at) const
+    {
+        return static_cast<uint16_t>(data[at] | (data[at + 1] << 8));
+    }
+
+    uint32_t Read32(size_t at) const
+    {
+        return static_cast<uint32_t>(data[at]) | (static_cast<uint32_t>(data[at + 1]) << 8) |
+               (static_cast<uint32_t>(data[at + 2]) << 16) | (static_cast<uint32_t>(data[at + 3]) << 24);
+    }
+
+    size_t FrameOffset(int frame) const
+    {
+        return Read32(HEADER_SIZE + 4 * static_cast<size_t>(frame));
+    }
+
+    bool IsKey(int frame) const
+    {
+        size_t at = FrameOffset(frame);
+        return at < dataSize && !(data[at] & FRAME_DELTA);
+    }
+
+    static int Hash(uint32_t px)
+    {
+        return ((px & 255) * 3 + ((px >> 8) & 255) * 5 + ((px >> 16) & 255) * 7 + (px >> 24) * 11) % 64;
+    }
+
+    // applique une frame (image clé ou delta) sur le canvas
+    bool Apply(int frame)
+    {
+        size_t at = FrameOffset(frame);
+        size_t end = FrameOffset(frame + 1);
+        if (at >= end || end > dataSize || at + 5 > end)
+            return false;
+
+        bool key = !(data[at] & FRAME_DELTA);
+        uint32_t rawSize = Read32(at + 1);
+        at += 5;
+        raw.resize(rawSize);
+        if (!Decompress(&data[at], end - at, raw.data(), rawSize))
+            return false;
+
+        // pixels en mots 32 bits, r dans l'octet bas comme dans le convertisseur
+        uint32_t *pixels = reinterpret_cast<uint32_t *>(canvas.data());
+        const size_t n = static_cast<size_t>(width) * height;
+        uint32_t index[64] = {};
+        uint32_t px = 0xFF000000u;
+        size_t i = 0;
+
+        const uint8_t *src = raw.data();
+        const uint8_t *srcEnd = src + rawSize;
+        while (src < srcEnd)
+        {
+            uint8_t op = *src++;
+            if (op == OP_SKIP)
+            {
+                if (key)
+                    return false;
+                size_t count = 0;
+                int shift = 0;
+                uint8_t b;
+                do
+                {
+                    if (src >= srcEnd || shift > 28)
+                        return false;
+                    b = *src++;
+                    count |= static_cast<size_t>(b & 127) << shift;
+                    shift += 7;
+                } while (b & 128);
+                if (count == 0 || count > n - i)
+                    return false;
+                i += count;
+                px = pixels[i - 1];
+                continue;
+            }
+            if (i >= n)
+                return false;
+
+            if (op == OP_RGB || op == OP_RGBA)
+            {
+                size_t size = op == OP_RGB ? 3 : 4;
+                if (static_cast<size_t>(srcEnd - src) < size)
+                    return false;
+                uint32_t alpha = op == OP_RGB ? px & 0xFF000000u : static_cast<uint32_t>(src[3]) << 24;
+                px = src[0] | (src[1] << 8) | (src[2] << 16) | alpha;
+                src += size;
+            }
+            else if (op < 0x40) // INDEX
+            {
+                px = index[op];
+                pixels[i++] = px;
+                continue;
+            }
+            else if (op < 0x80) // DIFF
+            {
+                uint32_t r = (px + ((op >> 4) & 3) - 2) & 255;
+                uint32_t g = ((px >> 8) + ((op >> 2) & 3) - 2) & 255;
+                uint32_t b = ((px >> 16) + (op & 3) - 2) & 255;
+                px = r | (g << 8) | (b << 16) | (px & 0xFF000000u);
+            }
+            else if (op < 0xC0) // LUMA
+            {
+                if (src >= srcEnd)
+                    return false;
+                int dg = (op & 63) - 32;
+                int dr = dg + (*src >> 4) - 8;
+                int db = dg + (*src & 15) - 8;
+                ++src;
+                uint32_t r = (px + dr) & 255;
+                uint32_t g = ((px >> 8) + dg) & 255;
+                uint32_t b = ((px >> 16) + db) & 255;
+                px = r | (g << 8) | (b << 16) | (px & 0xFF000000u);
+            }
+            else // RUN
+            {
+                size_t count = (op & 63) + 1;
+                if (count > n - i)
+                    return false;
+                std::fill_n(pixels + i, count, px);
+                i += count;
+                continue;
+            }
+            index[Hash(px)] = px;
+            pixels[i++] = px;
+        }
+        return i == n;
+    }
+
+    static bool ReadLength(const uint8_t *&in, const uint8_t *inEnd, size_t &length)
+    {
+        uint8_t b;
+        do
+        {
+            if (in >= inEnd)
+                return false;
+            b = *in++;
+            length += b;
+        } while (b == 255);
+        return true;
+    }
+
+    // décompression d'un bloc LZ (format décrit dans cinematic_converter.py)
+    static bool Decompress(const uint8_t *in, size_t inSize, uint8_t *out, size_t outSize)
+    {
+        const uint8_t *inEnd = in + inSize;
+        uint8_t *op = out;
+        uint8_t *outEnd = out + outSize;
+
+        while (in < inEnd)
+        {
+            uint8_t token = *in++;
+            size_t literals = token >> 4;
+            if (literals == 15 && !ReadLength(in, inEnd, literals))
+                return false;
+            if (literals > static_cast<size_t>(inEnd - in) || literals > static_cast<size_t>(outEnd - op))
+                return false;
+            std::memcpy(op, in, literals);
+            op += literals;
+            in += literals;
+
+            if (in >= inEnd)
+                break; // dernière séquence : littéraux seuls
+
+            if (in + 2 > inEnd)
+                return false;
+            size_t offset = in[0] | (in[1] << 8);
+            in += 2;
+            size_t match = token & 15;
+            if (match == 15 && !ReadLength(in, inEnd, match))
+                return false;
+            match += 4;
+
+            if (offset == 0 || offset > static_cast<size_t>(op - out) || match > static_cast<size_t>(outEnd - op))
+                return false;
+            const uint8_t *ref = op - offset;
+            if (offset >= match)
+            {
+                std::memcpy(op, ref, match);
+                op += match;
+            }
+            else
+            {
+                // copie qui se recouvre : octet par octet
+                for (size_t k = 0; k < match; ++k)
+                    *op++ = *ref++;
+            }
+        }
+        return op == outEnd;
+    }
+
+    const uint8_t *data = nullptr;
+    size_t dataSize = 0;
+    std::string owned; // contenu du fichier libre, quand il n'est pas dans l'archive
+    std::vector<uint8_t> canvas;
+    std::vector<uint8_t> raw; // opérations de la frame en cours, décompressées
+
+    int width = 0, height = 0, frameCount = 0;
+    int decoded = -1;
+};
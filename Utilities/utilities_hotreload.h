@@ -0,0 +1,225 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Surveillance des fichiers de Assets/ pendant le développement (HOT_RELOAD).
+ * Linux : inotify sur chaque dossier, lu sans bloquer ; ailleurs : dates de modification comparées régulièrement.
+ * Un fichier n'est signalé qu'une fois resté sans écriture pendant HOT_RELOAD_DELAY_MS (éditeurs qui écrivent en plusieurs fois),
+ * puis chaque gestionnaire dont le suffixe correspond est appelé, depuis le thread principal.
+ */
+class HotReload
+{
+public:
+    using Handler = std::function<void(const std::string &)>;
+
+    static HotReload &Instance()
+    {
+        static HotReload instance;
+        return instance;
+    }
+
+    HotReload(HotReload const &) = delete;
+    HotReload &operator=(HotReload const &) = delete;
+
+    // surveille root et ses sous-dossiers ; les chemins signalés commencent par root ("Assets/...")
+    bool Start(const std::string &root)
+    {
+        Stop();
+        this->root = root;
+
+#ifdef __linux__
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0)
+        {
+            Debug::Error("HotReload: inotify_init1 failed, falling back to polling");
+        }
+        else
+        {
+            Watch(root);
+            std::error_code ec;
+            for (auto it = std::filesystem::recursive_directory_iterator(root, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+            {
+                if (it->is_directory(ec))
+                    Watch(it->path().generic_string());
+            }
+            Debug::Log("HotReload: watching " + std::to_string(directories.size()) + " directories under " + root);
+            return true;
+        }
+#endif
+        Scan(true);
+        Debug::Log("HotReload: polling " + std::to_string(modified.size()) + " files under " + root);
+        return true;
+    }
+
+    void Stop()
+    {
+#ifdef __linux__
+        if (fd >= 0)
+            close(fd);
+        fd = -1;
+#endif
+        directories.clear();
+        modified.clear();
+        changed.clear();
+    }
+
+    // appelé pour chaque fichier modifié dont le chemin finit par suffix
+    void On(const std::string &suffix, Handler handler)
+    {
+        handlers.push_back({suffix, std::move(handler)});
+    }
+
+    // une fois par frame, avant la mise à jour des niveaux
+    void Poll()
+    {
+        Uint32 now = SDL_GetTicks();
+#ifdef __linux__
+        if (fd >= 0)
+            ReadEvents(now);
+        else
+#endif
+        if (now - lastScan >= HOT_RELOAD_POLL_MS)
+        {
+            lastScan = now;
+            Scan(false);
+        }
+
+        std::vector<std::string> ready;
+        for (auto it = changed.begin(); it != changed.end();)
+        {
+            if (now - it->second >= HOT_RELOAD_DELAY_MS)
+            {
+                ready.push_back(it->first);
+                it = changed.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        for (const std::string &path : ready)
+        {
+            bool handled = false;
+            for (auto &[suffix, handler] : handlers)
+            {
+                if (path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0)
+                {
+                    handler(path);
+                    handled = true;
+                }
+            }
+            if (handled)
+                Debug::Log("HotReload: " + path);
+        }
+    }
+
+private:
+    HotReload() = default;
+    ~HotReload() = default;
+
+    std::string root;
+    std::vector<std::pair<std::string, Handler>> handlers;
+    std::map<std::string, Uint32> changed; // chemin -> dernière écriture vue
+    std::unordered_map<int, std::string> directories; // descripteur inotify -> dossier
+    std::unordered_map<std::string, std::filesystem::file_time_type> modified; // mode sans inotify
+    Uint32 lastScan = 0;
+
+#ifdef __linux__
+    int fd = -1;
+
+    void Watch(const std::string &directory)
+    {
+        // IN_MOVED_TO : la plupart des éditeurs écrivent un fichier temporaire puis le renomment
+        int wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd < 0)
+        {
+            Debug::Error("HotReload: cannot watch " + directory);
+            return;
+        }
+        directories[wd] = directory;
+    }
+
+    // dossier apparu en cours de partie : des fichiers ont pu y être écrits avant que la surveillance ne commence
+    void WatchNew(const std::string &directory, Uint32 now)
+    {
+        Watch(directory);
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(directory, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (it->is_directory(ec))
+                Watch(it->path().generic_string());
+            else
+                changed[it->path().generic_string()] = now;
+        }
+    }
+
+    void ReadEvents(Uint32 now)
+    {
+        alignas(inotify_event) char buffer[4096];
+        for (;;)
+        {
+            ssize_t length = read(fd, buffer, sizeof(buffer));
+            if (length <= 0)
+                return;
+
+            for (char *p = buffer; p < buffer + length;)
+            {
+                const inotify_event *event = reinterpret_cast<const inotify_event *>(p);
+                p += sizeof(inotify_event) + event->len;
+
+                auto dir = directories.find(event->wd);
+                if (dir == directories.end() || event->len == 0)
+                    continue;
+                std::string path = dir->second + "/" + event->name;
+
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                        WatchNew(path, now);
+                    continue;
+                }
+                // IN_CREATE seul : le contenu arrive avec le IN_CLOSE_WRITE qui suit
+                if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                    changed[path] = now;
+            }
+        }
+    }
+#endif
+
+    void Scan(bool initial)
+    {
+        Uint32 now = SDL_GetTicks();
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(root, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (!it->is_regular_file(ec))
+                continue;
+            auto time = it->last_write_time(ec);
+            if (ec)
+                continue;
+
+            std::string path = it->path().generic_string();
+            auto known = modified.find(path);
+            if (known == modified.end() || known->second != time)
+            {
+                modified[path] = time;
+                if (!initial)
+                    changed[path] = now;
+            }
+        }
+    }
+};
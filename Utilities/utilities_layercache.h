@@ -0,0 +1,175 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <utility>
+
+/**
+ * Calque statique (fond du niveau, décor) gardé dans une texture cible de la taille de la vue (STATIC_LAYER_CACHE).
+ * Il n'est redessiné en entier que si son contenu change (frame d'animation, morceau chargé, image rechargée) ;
+ * quand la caméra bouge, l'image est décalée d'une cible à l'autre et seules les bandes découvertes sont redessinées.
+ * Le calque est posé au pixel entier le plus proche, les sprites dynamiques restent dessinés par-dessus chaque frame.
+ * Les textures ne sont pas détruites ici : les caches vivent autant que le renderer, qui les libère avec lui.
+ */
+class LayerCache
+{
+public:
+    using DrawFunction = std::function<void(const Vector2D &origin)>;
+
+    // contenu perdu ou périmé partout (cibles remises à zéro par le pilote, image rechargée)
+    static void InvalidateAll()
+    {
+        ++Epoch();
+    }
+
+    /**
+     * @param origin   position à l'écran à laquelle draw place le calque
+     * @param content  clé du contenu : une clé différente force un dessin complet
+     * @param draw     dessine le calque via le SpriteBatch ; peut être appelé avec un rectangle de découpe actif
+     */
+    void Render(SDL_Renderer *renderer, const Vector2D &viewport, const Vector2D &origin, uint64_t content, const DrawFunction &draw)
+    {
+        int w = (int)viewport.x, h = (int)viewport.y;
+        if (disabled || w <= 0 || h <= 0)
+        {
+            draw(origin);
+            return;
+        }
+
+        SpriteBatch &batch = SpriteBatch::Instance();
+        batch.Flush(); // ce qui précède va à l'écran, pas dans la cible
+        if (!Resize(renderer, w, h))
+        {
+            draw(origin);
+            return;
+        }
+
+        int x = (int)std::lround(origin.x), y = (int)std::lround(origin.y);
+        int dx = x - cachedX, dy = y - cachedY;
+        bool full = !valid || content != cachedContent || epoch != Epoch() || std::abs(dx) >= w || std::abs(dy) >= h;
+        if (full || dx != 0 || dy != 0)
+        {
+            SDL_Texture *screen = SDL_GetRenderTarget(renderer);
+            Uint8 r, g, b, a;
+            SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+            // SDL remet l'échelle à 1 à chaque changement de cible (voir DynamicResolution)
+            float scaleX, scaleY;
+            SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+            Vector2D snapped{(float)x, (float)y};
+            if (full)
+            {
+                SDL_SetRenderTarget(renderer, front);
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+                SDL_RenderClear(renderer);
+                draw(snapped);
+                batch.Flush();
+            }
+            else
+            {
+                Scroll(renderer, w, h, dx, dy, snapped, draw);
+            }
+            SDL_SetRenderTarget(renderer, screen);
+            SDL_RenderSetScale(renderer, scaleX, scaleY);
+            SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+            valid = true;
+            cachedContent = content;
+            epoch = Epoch();
+            cachedX = x;
+            cachedY = y;
+        }
+
+        batch.Draw(renderer, front, w, h, {0, 0, w, h}, {0.0f, 0.0f, (float)w, (float)h});
+    }
+
+private:
+    SDL_Texture *front = nullptr, *back = nullptr;
+    int width = 0, height = 0;
+    int cachedX = 0, cachedY = 0;
+    uint64_t cachedContent = 0;
+    unsigned epoch = 0;
+    bool valid = false, disabled = false;
+
+    static unsigned &Epoch()
+    {
+        static unsigned epoch = 0;
+        return epoch;
+    }
+
+    // dessiné sur une cible transparente, le calque y est prémultiplié par son alpha : il est posé tel quel à l'écran
+    static SDL_BlendMode CompositeMode()
+    {
+        return SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                          SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    }
+
+    static SDL_Texture *CreateTarget(SDL_Renderer *renderer, int w, int h)
+    {
+        SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (texture)
+            SDL_SetTextureBlendMode(texture, CompositeMode());
+        return texture;
+    }
+
+    bool Resize(SDL_Renderer *renderer, int w, int h)
+    {
+        if (front && w == width && h == height)
+            return true;
+
+        if (front)
+            SDL_DestroyTexture(front);
+        if (back)
+            SDL_DestroyTexture(back);
+        front = back = nullptr;
+        valid = false;
+
+        if (SDL_RenderTargetSupported(renderer))
+        {
+            front = CreateTarget(renderer, w, h);
+            back = CreateTarget(renderer, w, h);
+        }
+        if (!front || !back)
+        {
+            // le calque est alors dessiné directement, comme sans STATIC_LAYER_CACHE
+            Debug::Error(std::string("LayerCache: render targets unavailable: ") + SDL_GetError());
+            disabled = true;
+            return false;
+        }
+        width = w;
+        height = h;
+        return true;
+    }
+
+    // l'ancienne image est recopiée décalée dans l'autre cible, puis les bandes découvertes sont dessinées
+    void Scroll(SDL_Renderer *renderer, int w, int h, int dx, int dy, const Vector2D &origin, const DrawFunction &draw)
+    {
+        SDL_SetRenderTarget(renderer, back);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+
+        // copie exacte, transparence comprise
+        SDL_SetTextureBlendMode(front, SDL_BLENDMODE_NONE);
+        SDL_Rect shifted{dx, dy, w, h};
+        SDL_RenderCopy(renderer, front, nullptr, &shifted);
+        SDL_SetTextureBlendMode(front, CompositeMode());
+
+        SDL_Rect strips[2];
+        int count = 0;
+        if (dx != 0)
+            strips[count++] = {dx > 0 ? 0 : w + dx, 0, std::abs(dx), h};
+        if (dy != 0)
+            strips[count++] = {0, dy > 0 ? 0 : h + dy, w, std::abs(dy)};
+        for (int i = 0; i < count; ++i)
+        {
+            SDL_RenderSetClipRect(renderer, &strips[i]);
+            draw(origin);
+            SpriteBatch::Instance().Flush();
+        }
+        SDL_RenderSetClipRect(renderer, nullptr);
+
+        std::swap(front, back);
+    }
+};
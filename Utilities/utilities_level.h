@@ -0,0 +1,157 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Niveau précompilé par level_compiler.py : rectangles de collision, grille de navigation, dégagement
+ * et points d'apparition/sortie, lus directement dans l'archive projetée (aucune analyse de JSON).
+ *
+ * Format (little-endian) :
+ *     en-tête : "RLVL", u16 version, u16 drapeaux, u32 somme FNV-1a des données, u32 taille des données,
+ *               u16 largeur, u16 hauteur de la grille, u32 nombre de rectangles,
+ *               f32 x, y d'apparition, f32 x, y de sortie
+ *     données : rectangles (i32 x, y, largeur, hauteur en pixels du niveau),
+ *               grille (un octet par case, 1 = mur), dégagement (un octet par case, voir Astar::BuildClearance)
+ */
+class LevelFile
+{
+public:
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t FLAG_POINTS = 1; // apparition et sortie renseignées
+
+    // faux sans message si le fichier n'existe pas (le niveau repasse alors par le JSON)
+    bool Open(const std::string &path)
+    {
+        AssetPack &pack = AssetPack::Instance();
+        if (!pack.View(path, data, dataSize))
+        {
+            if (!pack.Exists(path) || !pack.Read(path, owned))
+                return false;
+            data = reinterpret_cast<const uint8_t *>(owned.data());
+            dataSize = owned.size();
+        }
+
+        if (dataSize < HEADER_SIZE || std::memcmp(data, "RLVL", 4) != 0)
+        {
+            Debug::Error("LevelFile: invalid file " + path);
+            return false;
+        }
+        uint16_t version = Read16(4);
+        if (version != VERSION)
+        {
+            Debug::Error("LevelFile: unsupported version " + std::to_string(version) + " in " + path + ", recompile it");
+            return false;
+        }
+
+        flags = Read16(6);
+        width = Read16(16);
+        height = Read16(18);
+        rectCount = Read32(20);
+        size_t payload = Read32(12);
+        size_t expected = static_cast<size_t>(rectCount) * RECT_SIZE + static_cast<size_t>(width) * height * 2;
+        if (payload != expected || HEADER_SIZE + payload > dataSize)
+        {
+            Debug::Error("LevelFile: truncated file " + path);
+            return false;
+        }
+        if (Checksum(data + HEADER_SIZE, payload) != Read32(8))
+        {
+            Debug::Error("LevelFile: checksum mismatch in " + path);
+            return false;
+        }
+        return true;
+    }
+
+    size_t RectCount() const
+    {
+        return rectCount;
+    }
+
+    CoupleRect Rect(size_t i) const
+    {
+        size_t at = HEADER_SIZE + i * RECT_SIZE;
+        return MakeCoupleRect(static_cast<int32_t>(Read32(at)), static_cast<int32_t>(Read32(at + 4)),
+                              static_cast<int32_t>(Read32(at + 8)), static_cast<int32_t>(Read32(at + 12)));
+    }
+
+    Astar::Grid NavGrid() const
+    {
+        const uint8_t *cells = GridData();
+        Astar::Grid grid(height, std::vector<bool>(width, false));
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                grid[y][x] = cells[y * width + x] != 0;
+        return grid;
+    }
+
+    std::vector<uint8_t> Clearance() const
+    {
+        const uint8_t *cells = GridData() + static_cast<size_t>(width) * height;
+        return std::vector<uint8_t>(cells, cells + static_cast<size_t>(width) * height);
+    }
+
+    bool HasPoints() const
+    {
+        return flags & FLAG_POINTS;
+    }
+
+    Vector2D Spawn() const
+    {
+        return {ReadFloat(24), ReadFloat(28)};
+    }
+
+    Vector2D Exit() const
+    {
+        return {ReadFloat(32), ReadFloat(36)};
+    }
+
+    // FNV-1a 32 bits, identique à celle de level_compiler.py
+    static uint32_t Checksum(const uint8_t *bytes, size_t length)
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE = 40;
+    static constexpr size_t RECT_SIZE = 16;
+
+    const uint8_t *GridData() const
+    {
+        return data + HEADER_SIZE + static_cast<size_t>(rectCount) * RECT_SIZE;
+    }
+
+    uint16_t Read16(size_t at) const
+    {
+        return static_cast<uint16_t>(data[at] | (data[at + 1] << 8));
+    }
+
+    uint32_t Read32(size_t at) const
+    {
+        return static_cast<uint32_t>(data[at]) | (static_cast<uint32_t>(data[at + 1]) << 8) |
+               (static_cast<uint32_t>(data[at + 2]) << 16) | (static_cast<uint32_t>(data[at + 3]) << 24);
+    }
+
+    float ReadFloat(size_t at) const
+    {
+        uint32_t bits = Read32(at);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    const uint8_t *data = nullptr;
+    size_t dataSize = 0;
+    std::string owned; // copie du fichier libre quand il n'est pas dans l'archive
+    uint16_t flags = 0, width = 0, height = 0;
+    uint32_t rectCount = 0;
+};
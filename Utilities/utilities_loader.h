@@ -0,0 +1,414 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL_mixer.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+/**
+ * Groupe de ressources chargées ensemble ; onReady crée les objets qui les utilisent.
+ */
+struct AssetBundle
+{
+    std::string name;
+    std::vector<std::string> dependencies;                    // bundles prêts avant l'appel de onReady
+    std::vector<std::string> textures;                        // envoyées au TextureCache (chemins depuis le dossier du jeu)
+    std::vector<std::string> images;                          // décodées seulement, reprises par Atlas::Pack
+    std::vector<std::pair<std::string, std::string>> sounds;  // id, chemin depuis Assets/Sounds/
+    std::function<void()> onReady;                            // thread principal
+};
+
+/**
+ * Chargement en arrière-plan : des threads décodent les PNG et les sons en parallèle,
+ * le thread principal envoie les textures et appelle les onReady dans un budget de temps par frame.
+ * Les bundles sont décodés dans l'ordre d'ajout, le premier peut donc s'afficher avant les suivants.
+ * Un bundle complété ne garde que son nom et sa taille (IsReady, Bytes, dépendances) jusqu'à Release.
+ */
+class AssetLoader
+{
+public:
+    static AssetLoader &Instance()
+    {
+        // jamais détruit : les threads sont arrêtés par Shutdown, avant IMG_Quit
+        static AssetLoader *instance = new AssetLoader();
+        return *instance;
+    }
+
+    void Start(unsigned threadCount = ASSET_LOADER_THREADS)
+    {
+        if (!workers.empty())
+            return;
+
+        unsigned hardware = std::thread::hardware_concurrency();
+        unsigned count = hardware > 1 ? std::min(threadCount, hardware - 1) : 1;
+        count = std::max(count, 1u);
+        for (unsigned i = 0; i < count; ++i)
+            workers.emplace_back(&AssetLoader::WorkerLoop, this);
+        Debug::Log("AssetLoader: " + std::to_string(count) + " thread(s)");
+    }
+
+    void Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+            jobs.clear();
+        }
+        cv.notify_all();
+        for (std::thread &worker : workers)
+            worker.join();
+        workers.clear();
+
+        for (Result &result : results)
+            Free(result);
+        results.clear();
+        for (auto &[path, surface] : decoded)
+            SDL_FreeSurface(surface);
+        decoded.clear();
+    }
+
+    void Enqueue(AssetBundle bundle)
+    {
+        for (const std::string &dep : bundle.dependencies)
+        {
+            if (!Known(dep))
+                Debug::Error("AssetLoader: bundle '" + bundle.name + "' depends on unknown bundle '" + dep + "'");
+        }
+
+        size_t index = nextBundle++;
+        BundleState &state = bundles[index];
+        state.desc = std::move(bundle);
+        names[state.desc.name] = index;
+        ++totalBundles;
+        state.remaining = state.desc.textures.size() + state.desc.images.size() + state.desc.sounds.size();
+        state.start = SDL_GetPerformanceCounter();
+        totalJobs += state.remaining;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const std::string &path : state.desc.textures)
+                jobs.push_back({index, JobKind::Texture, path, path});
+            for (const std::string &path : state.desc.images)
+                jobs.push_back({index, JobKind::Image, path, path});
+            for (const auto &[id, path] : state.desc.sounds)
+                jobs.push_back({index, JobKind::Sound, id, "Assets/Sounds/" + path});
+        }
+        cv.notify_all();
+    }
+
+    /**
+     * A appeler une fois par frame : envoie les textures décodées puis termine les bundles complets.
+     * Au moins un envoi et un bundle sont traités par appel, même si le budget est dépassé.
+     */
+    void Pump(SDL_Renderer *renderer, float budgetMs)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        auto elapsed = [start]
+        {
+            return (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+        };
+
+        bool first = true;
+        while (first || elapsed() < budgetMs)
+        {
+            Result result;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (results.empty())
+                    break;
+                result = std::move(results.front());
+                results.pop_front();
+            }
+            Finish(renderer, result);
+            first = false;
+        }
+
+        // les bundles terminés sont complétés dans l'ordre d'ajout puis retirés ; onReady peut en ajouter d'autres
+        first = true;
+        for (auto it = bundles.begin(); it != bundles.end();)
+        {
+            BundleState &state = it->second;
+            if (state.remaining > 0 || !DependenciesReady(state))
+            {
+                ++it;
+                continue;
+            }
+            if (!first && elapsed() >= budgetMs)
+                break;
+            names.erase(state.desc.name);
+            Complete(state);
+            it = bundles.erase(it);
+            first = false;
+        }
+    }
+
+    bool IsReady(const std::string &name) const
+    {
+        return completed.count(name) != 0;
+    }
+
+    bool IsIdle() const
+    {
+        return bundles.empty();
+    }
+
+    // avancement global entre 0 et 1 (ressources envoyées et bundles complétés)
+    float Progress() const
+    {
+        size_t total = totalJobs + totalBundles;
+        if (total == 0)
+            return 1.0f;
+        return static_cast<float>(doneJobs + readyBundles) / total;
+    }
+
+    // octets chargés par le bundle (textures et images décodées), pour les budgets mémoire
+    size_t Bytes(const std::string &name) const
+    {
+        auto done = completed.find(name);
+        if (done != completed.end())
+            return done->second;
+        auto it = names.find(name);
+        return it != names.end() ? bundles.at(it->second).bytes : 0;
+    }
+
+    /**
+     * Oublie un bundle complété (niveau déchargé, morceau reçu) : ses ressources appartiennent déjà aux objets créés.
+     * Un bundle dont d'autres dépendent encore ne doit pas être oublié. Peut être appelé depuis son onReady.
+     */
+    void Release(const std::string &name)
+    {
+        completed.erase(name);
+    }
+
+    /**
+     * Surface RGBA32 décodée d'un bundle en cours de complétion, nullptr si elle n'a pas été préchargée.
+     * L'appelant en devient propriétaire.
+     */
+    SDL_Surface *TakeSurface(const std::string &path)
+    {
+        auto it = decoded.find(path);
+        if (it == decoded.end())
+            return nullptr;
+        SDL_Surface *surface = it->second;
+        decoded.erase(it);
+        return surface;
+    }
+
+private:
+    AssetLoader() = default;
+
+    enum class JobKind
+    {
+        Texture,
+        Image,
+        Sound
+    };
+
+    struct Job
+    {
+        size_t bundle;
+        JobKind kind;
+        std::string key;  // chemin de l'image ou id du son
+        std::string path;
+    };
+
+    struct Result
+    {
+        size_t bundle = 0;
+        JobKind kind = JobKind::Texture;
+        std::string key;
+        SDL_Surface *surface = nullptr;
+        Mix_Chunk *chunk = nullptr;
+        std::string error; // journalisé par le thread principal
+    };
+
+    struct BundleState
+    {
+        AssetBundle desc;
+        size_t remaining = 0;
+        size_t bytes = 0;
+        std::vector<TextureHandle> textures; // gardées jusqu'à onReady, le TextureCache ne garde que des weak_ptr
+        Uint64 start = 0;
+    };
+
+    void WorkerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [this] { return quit || !jobs.empty(); });
+            if (quit)
+                break;
+
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+
+            lock.unlock();
+            Result result = Run(job);
+            lock.lock();
+
+            if (quit)
+            {
+                Free(result);
+                break;
+            }
+            results.push_back(std::move(result));
+        }
+    }
+
+    static Result Run(const Job &job)
+    {
+        Result result;
+        result.bundle = job.bundle;
+        result.kind = job.kind;
+        result.key = job.key;
+
+        if (job.kind == JobKind::Sound)
+        {
+            result.chunk = Mix_LoadWAV_RW(AssetPack::Instance().OpenRW(job.path), 1);
+            if (!result.chunk)
+                result.error = "Mix_LoadWAV failed for " + job.path + ": " + Mix_GetError();
+            return result;
+        }
+
+        SDL_Surface *surf = IMG_Load_RW(AssetPack::Instance().OpenRW(job.path), 1);
+        if (!surf)
+        {
+            result.error = "IMG_Load failed for " + job.path + ": " + IMG_GetError();
+            return result;
+        }
+        // conversion faite ici : le thread principal n'a plus qu'à envoyer les pixels
+        result.surface = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(surf);
+        if (!result.surface)
+            result.error = "SDL_ConvertSurfaceFormat failed for " + job.path + ": " + SDL_GetError();
+        return result;
+    }
+
+    static void Free(Result &result)
+    {
+        if (result.surface)
+            SDL_FreeSurface(result.surface);
+        if (result.chunk)
+            Mix_FreeChunk(result.chunk);
+        result.surface = nullptr;
+        result.chunk = nullptr;
+    }
+
+    void Finish(SDL_Renderer *renderer, Result &result)
+    {
+        ++doneJobs;
+        auto it = bundles.find(result.bundle);
+        if (it == bundles.end())
+        {
+            Free(result);
+            return;
+        }
+        BundleState &state = it->second;
+        --state.remaining;
+
+        if (!result.error.empty())
+        {
+            Debug::Error("AssetLoader: " + result.error);
+            return;
+        }
+
+        if (result.surface)
+            state.bytes += static_cast<size_t>(result.surface->w) * result.surface->h * 4;
+
+        switch (result.kind)
+        {
+        case JobKind::Texture:
+        {
+            // déjà envoyée par un autre bundle encore en mémoire : pas de doublon
+            if (TextureHandle existing = TextureCache::Instance().Find(result.key))
+            {
+                SDL_FreeSurface(result.surface);
+                state.textures.push_back(existing);
+                break;
+            }
+            SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, result.surface);
+            SDL_FreeSurface(result.surface);
+            if (!tex)
+            {
+                Debug::Error("AssetLoader: SDL_CreateTextureFromSurface failed for " + result.key + ": " + SDL_GetError());
+                return;
+            }
+            state.textures.push_back(TextureCache::Instance().Insert(result.key, tex));
+            break;
+        }
+        case JobKind::Image:
+        {
+            SDL_Surface *&slot = decoded[result.key];
+            if (slot)
+                SDL_FreeSurface(slot);
+            slot = result.surface;
+            break;
+        }
+        case JobKind::Sound:
+            SoundManager::Instance().RegisterChunk(result.key, result.chunk);
+            break;
+        }
+    }
+
+    // le bundle est marqué prêt avant onReady, qui peut lire Bytes ou appeler Release
+    void Complete(BundleState &state)
+    {
+        completed[state.desc.name] = state.bytes;
+        ++readyBundles;
+        if (state.desc.onReady)
+            state.desc.onReady();
+
+        // images qu'aucun atlas n'a reprises, et handles désormais tenus par les objets créés
+        for (const std::string &path : state.desc.images)
+        {
+            if (SDL_Surface *surface = TakeSurface(path))
+                SDL_FreeSurface(surface);
+        }
+        state.textures.clear();
+
+        float ms = (SDL_GetPerformanceCounter() - state.start) * 1000.0f / SDL_GetPerformanceFrequency();
+        Debug::Log("AssetLoader: bundle '" + state.desc.name + "' ready in " + std::to_string(static_cast<int>(ms)) + " ms");
+    }
+
+    bool DependenciesReady(const BundleState &state) const
+    {
+        for (const std::string &dep : state.desc.dependencies)
+        {
+            if (!IsReady(dep))
+                return false;
+        }
+        return true;
+    }
+
+    bool Known(const std::string &name) const
+    {
+        return names.count(name) || completed.count(name);
+    }
+
+    // thread principal ; map : onReady peut ajouter un bundle sans invalider les références, l'ordre d'ajout est gardé
+    std::map<size_t, BundleState> bundles;             // en cours, par numéro d'ajout
+    std::unordered_map<std::string, size_t> names;     // nom -> numéro des bundles en cours
+    std::unordered_map<std::string, size_t> completed; // nom -> octets des bundles complétés, jusqu'à Release
+    std::unordered_map<std::string, SDL_Surface *> decoded;
+    size_t nextBundle = 0;
+    size_t totalJobs = 0, doneJobs = 0, totalBundles = 0, readyBundles = 0;
+
+    // partagé avec les threads (protégé par mutex)
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Job> jobs;
+    std::deque<Result> results;
+    bool quit = false;
+
+    std::vector<std::thread> workers;
+};
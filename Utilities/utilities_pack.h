@@ -0,0 +1,238 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Archive de ressources produite par asset_packer.py, projetée en mémoire en une fois.
+ * Les lectures passent par des SDL_RWops sur la mémoire projetée (aucune copie, aucune ouverture de fichier) ;
+ * un chemin absent de l'archive, ou toute l'archive si elle manque, est lu depuis le fichier libre.
+ * La table est en lecture seule après Open : les threads de chargement peuvent l'utiliser.
+ */
+class AssetPack
+{
+public:
+    static AssetPack &Instance()
+    {
+        // jamais détruit : la projection reste valide tant que des RWops peuvent y lire
+        static AssetPack *instance = new AssetPack();
+        return *instance;
+    }
+
+    bool Open(const std::string &path)
+    {
+        if (!Map(path))
+        {
+            Debug::Log("AssetPack: " + path + " not found, using loose files");
+            return false;
+        }
+
+        if (size < HEADER_SIZE || std::memcmp(base, "RPAK", 4) != 0 || Read32(4) != VERSION)
+        {
+            Debug::Error("AssetPack: invalid or outdated pack " + path + ", using loose files");
+            Unmap();
+            return false;
+        }
+
+        uint32_t count = Read32(8);
+        size_t at = HEADER_SIZE;
+        size_t tableEnd = at + Read32(12);
+        if (tableEnd > size)
+        {
+            Debug::Error("AssetPack: corrupted table in " + path);
+            Unmap();
+            return false;
+        }
+
+        entries.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (at + ENTRY_SIZE > tableEnd)
+                break;
+            Entry entry{Read64(at), Read64(at + 8)};
+            size_t length = base[at + 16] | (base[at + 17] << 8);
+            at += ENTRY_SIZE;
+            if (at + length > tableEnd || entry.offset + entry.size > size)
+            {
+                Debug::Error("AssetPack: corrupted entry in " + path);
+                break;
+            }
+            entries.emplace(std::string(reinterpret_cast<const char *>(base + at), length), entry);
+            at += length;
+        }
+
+        Debug::Log("AssetPack: " + std::to_string(entries.size()) + " files mapped from " + path);
+        return true;
+    }
+
+    bool Contains(const std::string &path) const
+    {
+        return entries.count(Normalize(path)) != 0;
+    }
+
+    // dans l'archive ou en fichier libre
+    bool Exists(const std::string &path) const
+    {
+        if (Contains(path))
+            return true;
+        SDL_RWops *rw = SDL_RWFromFile(path.c_str(), "rb");
+        if (!rw)
+            return false;
+        SDL_RWclose(rw);
+        return true;
+    }
+
+    // données du fichier dans la projection, sans copie ; faux si le fichier n'est pas dans l'archive
+    bool View(const std::string &path, const uint8_t *&data, size_t &length) const
+    {
+        auto it = entries.find(Normalize(path));
+        if (it == entries.end())
+            return false;
+        data = base + it->second.offset;
+        length = static_cast<size_t>(it->second.size);
+        return true;
+    }
+
+    /**
+     * Flux de lecture à passer aux fonctions *_RW de SDL (IMG_Load_RW, Mix_LoadWAV_RW...) avec freesrc = 1.
+     * nullptr si le fichier n'existe nulle part.
+     */
+    SDL_RWops *OpenRW(const std::string &path) const
+    {
+        const uint8_t *data;
+        size_t length;
+        if (View(path, data, length))
+            return SDL_RWFromConstMem(data, static_cast<int>(length));
+        return SDL_RWFromFile(path.c_str(), "rb");
+    }
+
+    // copie complète du fichier (petits fichiers texte comme les hitbox JSON)
+    bool Read(const std::string &path, std::string &out) const
+    {
+        const uint8_t *data;
+        size_t length;
+        if (View(path, data, length))
+        {
+            out.assign(reinterpret_cast<const char *>(data), length);
+            return true;
+        }
+
+        SDL_RWops *rw = SDL_RWFromFile(path.c_str(), "rb");
+        if (!rw)
+            return false;
+        Sint64 fileSize = SDL_RWsize(rw);
+        out.resize(fileSize > 0 ? static_cast<size_t>(fileSize) : 0);
+        size_t read = out.empty() ? 0 : SDL_RWread(rw, &out[0], 1, out.size());
+        SDL_RWclose(rw);
+        return read == out.size();
+    }
+
+private:
+    AssetPack() = default;
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t ENTRY_SIZE = 18; // u64 offset, u64 taille, u16 longueur du chemin
+
+    struct Entry
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static std::string Normalize(const std::string &path)
+    {
+        std::string p = path;
+        std::replace(p.begin(), p.end(), '\\', '/');
+        while (p.compare(0, 2, "./") == 0)
+            p.erase(0, 2);
+        return p;
+    }
+
+    uint32_t Read32(size_t at) const
+    {
+        return static_cast<uint32_t>(base[at]) | (static_cast<uint32_t>(base[at + 1]) << 8) |
+               (static_cast<uint32_t>(base[at + 2]) << 16) | (static_cast<uint32_t>(base[at + 3]) << 24);
+    }
+
+    uint64_t Read64(size_t at) const
+    {
+        return static_cast<uint64_t>(Read32(at)) | (static_cast<uint64_t>(Read32(at + 4)) << 32);
+    }
+
+#ifdef _WIN32
+    bool Map(const std::string &path)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        HANDLE mapping = fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+        base = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return base != nullptr;
+    }
+
+    void Unmap()
+    {
+        if (base)
+            UnmapViewOfFile(base);
+        base = nullptr;
+        size = 0;
+        entries.clear();
+    }
+#else
+    bool Map(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            close(fd);
+            return false;
+        }
+        void *mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED)
+            return false;
+        base = static_cast<const uint8_t *>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    void Unmap()
+    {
+        if (base)
+            munmap(const_cast<uint8_t *>(base), size);
+        base = nullptr;
+        size = 0;
+        entries.clear();
+    }
+#endif
+
+    const uint8_t *base = nullptr;
+    size_t size = 0;
+    std::unordered_map<std::string, Entry> entries;
+};
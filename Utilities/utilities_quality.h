@@ -0,0 +1,162 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <cstdio>
+
+/**
+ * Gouverneur de qualité (QUALITY_GOVERNOR) : seul endroit qui compare la durée des frames au budget et choisit
+ * quel travail réduire. Chaque niveau de qualité fixe :
+ *  - la fréquence de mise à jour des ennemis hors écran puis à l'écran (Scene::UpdateAll),
+ *  - le nombre de recherches de chemin lancées par frame (Enemy::requestPathTo),
+ *  - la fréquence d'avance des animations (Animations::UpdatePlayers),
+ *  - l'échelle de rendu maximale (DynamicResolution, si DYNAMIC_RESOLUTION).
+ * Le niveau baisse après QUALITY_DEGRADE_DELAY s au-dessus du budget et remonte après QUALITY_RESTORE_DELAY s
+ * en dessous : les deux seuils et les deux délais forment l'hystérésis. Comme pour DynamicResolution, une remontée
+ * aussitôt annulée double l'attente avant la suivante. Chaque changement est écrit dans le journal.
+ */
+class QualityGovernor
+{
+public:
+    struct Level
+    {
+        int aiOffscreen;   // ennemis hors écran mis à jour une frame sur n
+        int aiOnscreen;    // ennemis à l'écran mis à jour une frame sur n
+        int pathBudget;    // recherches de chemin lancées par frame, 0 = sans limite
+        int animation;     // animations avancées une frame sur n
+        float renderScale; // échelle de rendu maximale
+    };
+
+    static QualityGovernor &Instance()
+    {
+        static QualityGovernor instance;
+        return instance;
+    }
+
+    QualityGovernor(QualityGovernor const &) = delete;
+    QualityGovernor &operator=(QualityGovernor const &) = delete;
+
+    // une fois par frame, avant les mises à jour, avec la durée de la frame précédente en secondes
+    void Update(float deltaTime)
+    {
+        ++frame;
+        pathRequests = 0;
+        sinceChange += deltaTime;
+
+        float ms = deltaTime * 1000.0f;
+        // un à-coup isolé (chargement) ne doit pas faire basculer le niveau
+        if (averageMs > 0.0f && ms > QUALITY_FRAME_BUDGET_MS * 4.0f)
+            return;
+        averageMs = averageMs <= 0.0f ? ms : averageMs + (ms - averageMs) * QUALITY_SMOOTHING;
+
+        if (averageMs > QUALITY_FRAME_BUDGET_MS * (1.0f + QUALITY_DEGRADE_MARGIN))
+        {
+            overTime += deltaTime;
+            underTime = 0.0f;
+            if (overTime >= QUALITY_DEGRADE_DELAY && level + 1 < LEVEL_COUNT)
+            {
+                // la remontée précédente n'a pas tenu : la prochaine attendra plus longtemps
+                if (lastRestored && sinceChange < restoreDelay)
+                    restoreDelay = std::min(restoreDelay * 2.0f, QUALITY_RESTORE_DELAY_MAX);
+                SetLevel(level + 1, "over budget");
+            }
+        }
+        else if (averageMs < QUALITY_FRAME_BUDGET_MS * (1.0f + QUALITY_RESTORE_MARGIN))
+        {
+            underTime += deltaTime;
+            overTime = 0.0f;
+            if (underTime >= restoreDelay && level > 0)
+            {
+                // une remontée qui a tenu tout un délai remet l'attente au minimum
+                if (lastRestored && sinceChange >= restoreDelay)
+                    restoreDelay = QUALITY_RESTORE_DELAY;
+                SetLevel(level - 1, "headroom");
+            }
+        }
+        else
+        {
+            // entre les deux seuils : on garde le niveau
+            overTime = underTime = 0.0f;
+        }
+    }
+
+    // 0 = pleine qualité
+    int CurrentLevel() const
+    {
+        return level;
+    }
+
+    const Level &Current() const
+    {
+        return LEVELS[level];
+    }
+
+    float AverageFrameMs() const
+    {
+        return averageMs;
+    }
+
+    /**
+     * Vrai si l'objet est mis à jour cette frame, une frame sur divisor ; les objets sont répartis sur les frames
+     * selon leur adresse pour que le travail ne tombe pas sur la même frame.
+     */
+    bool RunsThisFrame(const void *owner, int divisor) const
+    {
+        if (divisor <= 1)
+            return true;
+        uint64_t slot = reinterpret_cast<uintptr_t>(owner) >> 6;
+        return (frame + slot) % (uint64_t)divisor == 0;
+    }
+
+    // une recherche de chemin peut-elle partir cette frame ; sinon l'ennemi redemande à la suivante
+    bool AllowPathRequest()
+    {
+        int budget = Current().pathBudget;
+        if (budget == 0)
+            return true;
+        if (pathRequests >= budget)
+            return false;
+        ++pathRequests;
+        return true;
+    }
+
+private:
+    QualityGovernor() = default;
+    ~QualityGovernor() = default;
+
+    int level = 0;
+    uint64_t frame = 0;
+    int pathRequests = 0;
+    float averageMs = 0.0f;
+    float overTime = 0.0f, underTime = 0.0f;
+    float sinceChange = 0.0f;
+    float restoreDelay = QUALITY_RESTORE_DELAY;
+    bool lastRestored = false;
+
+    // ce qui se voit le moins part en premier : IA hors écran, puis chemins et animations, l'IA à l'écran en dernier
+    static constexpr Level LEVELS[] = {
+        {1, 1, 0, 1, 1.0f},
+        {2, 1, 8, 1, 1.0f},
+        {4, 1, 4, 2, 0.85f},
+        {8, 2, 2, 2, 0.7f},
+    };
+    static constexpr int LEVEL_COUNT = sizeof(LEVELS) / sizeof(LEVELS[0]);
+
+    void SetLevel(int next, const char *reason)
+    {
+        lastRestored = next < level;
+        level = next;
+        sinceChange = overTime = underTime = 0.0f;
+        const Level &l = Current();
+        if (DYNAMIC_RESOLUTION)
+            DynamicResolution::Instance().SetRange(DYNAMIC_RES_MIN_SCALE, l.renderScale);
+
+        char text[256];
+        std::snprintf(text, sizeof(text),
+                      "QualityGovernor: level %d (%s, %.1f ms for %.1f ms): AI 1/%d off-screen 1/%d on-screen, %d path requests/frame, animations 1/%d, render scale <= %.2f",
+                      level, reason, averageMs, QUALITY_FRAME_BUDGET_MS, l.aiOffscreen, l.aiOnscreen, l.pathBudget, l.animation, l.renderScale);
+        Debug::Log(text);
+    }
+};
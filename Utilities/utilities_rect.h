@@ -1,9 +1,10 @@
 #pragma once
 
-#include <fstream>
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include <cstdint>
+#include <algorithm>
 #include <nlohmann/json.hpp> 
 
 struct BoxRect {
@@ -25,39 +26,86 @@ struct CoupleRect
     {}
 };
 
-std::vector<CoupleRect> LoadRects(const std::string& filepath) {
-    std::ifstream in{filepath};
-    if (!in.is_open()) {
+// rectangle en pixels du niveau (coin haut-gauche) -> boîte centrée sur le niveau, en demi-dimensions
+inline CoupleRect MakeCoupleRect(int x0, int y0, int width, int height) {
+    int cx = x0 - 50 + width  / 2;
+    int cy = y0 - 50 + height / 2;
+
+    int rw = width  / 2;
+    int rh = height / 2;
+
+    BoxRect  br{ cx, cy, rw, rh };
+    SDL_Rect sr{ x0, y0, width, height };
+    return CoupleRect(br, sr);
+}
+
+// faux (message journalisé, crects inchangé) si le fichier manque ou n'est pas un tableau de rectangles valide
+inline bool LoadRects(const std::string& filepath, std::vector<CoupleRect>& crects) {
+    std::string text;
+    if (!AssetPack::Instance().Read(filepath, text)) {
         Debug::Error("Impossible d'ouvrir le fichier JSON : " + filepath);
+        return false;
     }
 
-    nlohmann::json j;
-    in >> j;
-    if (!j.is_array()) {
-        Debug::Error("JSON invalide : attendu un tableau de rectangles");
+    nlohmann::json j = nlohmann::json::parse(text, nullptr, false);
+    if (j.is_discarded() || !j.is_array()) {
+        Debug::Error("JSON invalide : attendu un tableau de rectangles dans " + filepath);
+        return false;
     }
 
-    std::vector<CoupleRect> crects;
-    crects.reserve(j.size());
+    std::vector<CoupleRect> loaded;
+    loaded.reserve(j.size());
+    try {
+        for (const auto& item : j) {
 
-    for (const auto& item : j) {
+            int x0     = item.at("x").get<int>();
+            int y0     = item.at("y").get<int>();
+            int width  = item.at("width").get<int>();
+            int height = item.at("height").get<int>();
 
-        int x0     = item.at("x").get<int>();
-        int y0     = item.at("y").get<int>();    
-        int width  = item.at("width").get<int>();  
-        int height = item.at("height").get<int>();
+            loaded.push_back(MakeCoupleRect(x0, y0, width, height));
+        }
+    } catch (const nlohmann::json::exception& e) {
+        Debug::Error("JSON invalide dans " + filepath + " : " + e.what());
+        return false;
+    }
 
-        int cx = x0 - 50 + width  / 2;
-        int cy = y0 - 50 + height / 2;
+    crects = std::move(loaded);
+    return true;
+}
+
+/**
+ * Regroupe des rectangles qui se chevauchent ou se touchent en un recouvrement de grands rectangles
+ * (les cases couvertes restent les mêmes, les parties hors du niveau size x size sont ignorées).
+ * Chaque case pas encore couverte démarre un rectangle étendu à droite puis vers le bas tant que les cases sont pleines.
+ * Même calcul que merge_rects dans level_compiler.py.
+ */
+inline std::vector<CoupleRect> MergeRects(const std::vector<CoupleRect>& rects, int size = 100) {
+    std::vector<uint8_t> solid(size * size, 0), covered(size * size, 0);
+    for (const CoupleRect& c : rects) {
+        const SDL_Rect& r = c.sdlrect;
+        for (int y = std::max(0, r.y); y < std::min(size, r.y + r.h); ++y)
+            for (int x = std::max(0, r.x); x < std::min(size, r.x + r.w); ++x)
+                solid[y * size + x] = 1;
+    }
 
-        int rw = width  / 2;
-        int rh = height / 2;
+    std::vector<CoupleRect> merged;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            if (!solid[y * size + x] || covered[y * size + x])
+                continue;
 
-        BoxRect  br{ cx, cy, rw, rh };
-        SDL_Rect sr{ x0, y0, width, height };
+            int w = 1;
+            while (x + w < size && solid[y * size + x + w])
+                ++w;
+            int h = 1;
+            while (y + h < size && std::all_of(&solid[(y + h) * size + x], &solid[(y + h) * size + x + w], [](uint8_t s) { return s != 0; }))
+                ++h;
 
-        crects.emplace_back(br, sr);
+            for (int yy = y; yy < y + h; ++yy)
+                std::fill(&covered[yy * size + x], &covered[yy * size + x + w], 1);
+            merged.push_back(MakeCoupleRect(x, y, w, h));
+        }
     }
-
-    return crects;
+    return merged;
 }
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Résolution dynamique (DYNAMIC_RESOLUTION) : la frame est dessinée dans une texture cible de la taille de l'écran,
+ * avec SDL_RenderSetScale(scale) ; seul le coin de scale x taille est rempli, puis étiré sur la fenêtre.
+ * Les coordonnées du jeu ne changent pas (SDL_GetRendererOutputSize renvoie la taille de la cible) : seul le nombre
+ * de pixels dessinés baisse.
+ *
+ * L'échelle suit la durée moyenne des frames : elle baisse d'un cran dès que la moyenne dépasse la cible,
+ * et remonte d'un cran après DYNAMIC_RES_UP_DELAY s passées sous la cible. Avec la synchronisation verticale,
+ * une frame qui tient la cible ne dit pas quelle marge il reste : chaque remontée est donc un essai, et une remontée
+ * suivie d'une baisse double le délai avant la suivante, pour ne pas osciller autour de la limite.
+ */
+class DynamicResolution
+{
+public:
+    static DynamicResolution &Instance()
+    {
+        static DynamicResolution instance;
+        return instance;
+    }
+
+    DynamicResolution(DynamicResolution const &) = delete;
+    DynamicResolution &operator=(DynamicResolution const &) = delete;
+
+    // réglages, modifiables en jeu ; l'échelle est ramenée dans [minScale, maxScale]
+    void SetTarget(float frameMs)
+    {
+        targetMs = frameMs;
+    }
+
+    void SetRange(float minScale, float maxScale)
+    {
+        this->minScale = std::min(minScale, maxScale);
+        this->maxScale = std::max(minScale, maxScale);
+        scale = std::clamp(scale, this->minScale, this->maxScale);
+    }
+
+    // échelle imposée (essais, réglage graphique) : le contrôleur ne la modifie plus ; 0 le relance
+    void SetFixedScale(float fixed)
+    {
+        fixedScale = fixed;
+        if (fixed > 0.0f)
+            scale = std::clamp(fixed, minScale, maxScale);
+    }
+
+    float Scale() const
+    {
+        return scale;
+    }
+
+    float TargetMs() const
+    {
+        return targetMs;
+    }
+
+    float AverageFrameMs() const
+    {
+        return averageMs;
+    }
+
+    bool IsActive() const
+    {
+        return target != nullptr;
+    }
+
+    // une fois par frame, avec la durée de la frame précédente en secondes
+    void Update(float deltaTime)
+    {
+        float ms = deltaTime * 1000.0f;
+        sinceChange += deltaTime;
+        // chargement de niveau, fenêtre déplacée : un à-coup isolé ne dit rien de la charge de rendu
+        if (averageMs > 0.0f && ms > targetMs * 4.0f)
+            return;
+        averageMs = averageMs <= 0.0f ? ms : averageMs + (ms - averageMs) * DYNAMIC_RES_SMOOTHING;
+        if (fixedScale > 0.0f)
+            return;
+
+        if (averageMs > targetMs * (1.0f + DYNAMIC_RES_TOLERANCE))
+        {
+            if (sinceChange < DYNAMIC_RES_DOWN_DELAY || scale <= minScale)
+                return;
+            // la dernière remontée n'a pas tenu : la prochaine attendra plus longtemps
+            if (lastStepUp && sinceChange < upDelay)
+                upDelay = std::min(upDelay * 2.0f, DYNAMIC_RES_UP_DELAY_MAX);
+            Step(-DYNAMIC_RES_STEP, false);
+        }
+        else if (sinceChange >= upDelay && scale < maxScale)
+        {
+            // une remontée qui a tenu tout un délai remet l'attente au minimum
+            if (lastStepUp)
+                upDelay = DYNAMIC_RES_UP_DELAY;
+            Step(DYNAMIC_RES_STEP, true);
+        }
+    }
+
+    // avant tout dessin de la frame
+    void Begin(SDL_Renderer *renderer)
+    {
+        if (disabled)
+            return;
+
+        int w, h;
+        SDL_GetRendererOutputSize(renderer, &w, &h);
+        if (!Resize(renderer, w, h))
+            return;
+
+        SDL_SetRenderTarget(renderer, target);
+        SDL_RenderSetScale(renderer, scale, scale);
+    }
+
+    // après la scène, avant l'affichage : le coin dessiné est étiré sur la fenêtre
+    void End(SDL_Renderer *renderer)
+    {
+        if (!target)
+            return;
+
+        SpriteBatch::Instance().Flush();
+        SDL_SetRenderTarget(renderer, nullptr);
+        SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+
+        SDL_Rect src{0, 0, std::min(width, (int)std::ceil(width * scale)), std::min(height, (int)std::ceil(height * scale))};
+        SDL_RenderCopy(renderer, target, &src, nullptr);
+    }
+
+private:
+    DynamicResolution() = default;
+    ~DynamicResolution() = default;
+
+    SDL_Texture *target = nullptr; // libérée avec le renderer
+    int width = 0, height = 0;
+    float scale = 1.0f;
+    float fixedScale = 0.0f;
+    float targetMs = DYNAMIC_RES_TARGET_MS;
+    float minScale = DYNAMIC_RES_MIN_SCALE, maxScale = 1.0f;
+    float averageMs = 0.0f;
+    float sinceChange = 0.0f;
+    float upDelay = DYNAMIC_RES_UP_DELAY;
+    bool lastStepUp = false;
+    bool disabled = false;
+
+    void Step(float step, bool up)
+    {
+        scale = std::clamp(scale + step, minScale, maxScale);
+        sinceChange = 0.0f;
+        lastStepUp = up;
+    }
+
+    bool Resize(SDL_Renderer *renderer, int w, int h)
+    {
+        if (target && w == width && h == height)
+            return true;
+
+        if (target)
+            SDL_DestroyTexture(target);
+        target = nullptr;
+
+        if (SDL_RenderTargetSupported(renderer))
+            target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!target)
+        {
+            Debug::Error(std::string("DynamicResolution: render target unavailable, drawing at native resolution: ") + SDL_GetError());
+            disabled = true;
+            return false;
+        }
+        SDL_SetTextureScaleMode(target, SDL_ScaleModeLinear);
+        width = w;
+        height = h;
+        return true;
+    }
+};
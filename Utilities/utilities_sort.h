@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+namespace Sort
+{
+    // clé de tri 64 bits associée à l'indice de l'élément trié
+    struct KeyIndex
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /**
+     * Tri par base (LSD, 8 bits par passe) des clés 64 bits, stable.
+     * Les passes dont l'octet est identique pour toutes les clés sont sautées.
+     *
+     * @param items    les éléments à trier (résultat trié en place)
+     * @param scratch  tampon réutilisé d'une frame à l'autre pour éviter les allocations
+     */
+    inline void RadixSort64(std::vector<KeyIndex> &items, std::vector<KeyIndex> &scratch)
+    {
+        const size_t n = items.size();
+        if (n < 2)
+            return;
+
+        uint32_t counts[8][256];
+        std::memset(counts, 0, sizeof(counts));
+        for (const KeyIndex &item : items)
+        {
+            uint64_t k = item.key;
+            for (int pass = 0; pass < 8; ++pass)
+            {
+                ++counts[pass][(k >> (pass * 8)) & 0xFF];
+            }
+        }
+
+        scratch.resize(n);
+        KeyIndex *src = items.data();
+        KeyIndex *dst = scratch.data();
+
+        for (int pass = 0; pass < 8; ++pass)
+        {
+            uint32_t *count = counts[pass];
+            int shift = pass * 8;
+
+            // tous les éléments ont le même octet : la passe ne change rien
+            if (count[(src[0].key >> shift) & 0xFF] == n)
+                continue;
+
+            uint32_t offset = 0;
+            for (int b = 0; b < 256; ++b)
+            {
+                uint32_t c = count[b];
+                count[b] = offset;
+                offset += c;
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                dst[count[(src[i].key >> shift) & 0xFF]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != items.data())
+        {
+            std::memcpy(items.data(), src, n * sizeof(KeyIndex));
+        }
+    }
+}
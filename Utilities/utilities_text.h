@@ -3,6 +3,10 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
 
 namespace Text
 {
@@ -20,33 +24,192 @@ namespace Text
     };
     
     /**
-     * Affiche du texte positionné selon un point d'ancrage et un pivot.
-     *
-     * @param renderer       SDL_Renderer*
-     * @param font           TTF_Font* (déjà chargé)
-     * @param text           std::string, le texte à afficher
-     * @param AnchorPointx   int, offset en X depuis l'ancre
-     * @param AnchorPointy   int, offset en Y depuis l'ancre
-     * @param anchorBase     Anchor, point d'ancrage sur la fenêtre
-     * @param pivotPoint     Anchor, point pivot du texte
-     * @param color          SDL_Color (par défaut blanc)
+     * Glyphes Latin-1 d'une police (police + taille) rastérisés une seule fois dans une texture,
+     * le texte est ensuite composé de quads pris dans cette texture.
      */
-    inline void WriteText(SDL_Renderer* renderer,
-                          TTF_Font*      font,
-                          const std::string& text,
-                          int AnchorPointx,
-                          int AnchorPointy,
-                          Anchor anchorBase,
-                          Anchor pivotPoint,
-                          SDL_Color color = {255,255,255,255})
+    class GlyphAtlas
+    {
+    public:
+        struct GlyphQuad
+        {
+            SDL_Rect src;
+            SDL_FRect dst; // relatif au coin haut-gauche du texte
+        };
+
+        struct Layout
+        {
+            std::vector<GlyphQuad> quads;
+            int width = 0;
+            int height = 0;
+        };
+
+        GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font)
+        {
+            lineHeight = TTF_FontHeight(font);
+
+            std::vector<SDL_Surface *> surfaces(GLYPH_COUNT, nullptr);
+            for (int c = FIRST_GLYPH; c < GLYPH_COUNT; ++c)
+            {
+                if (!TTF_GlyphIsProvided(font, static_cast<Uint16>(c)))
+                    continue;
+                int minx, maxx, miny, maxy, advance;
+                if (TTF_GlyphMetrics(font, static_cast<Uint16>(c), &minx, &maxx, &miny, &maxy, &advance) != 0)
+                    continue;
+                glyphs[c].advance = advance;
+                glyphs[c].present = true;
+
+                SDL_Surface *surf = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(c), {255, 255, 255, 255});
+                if (!surf)
+                    continue;
+                surfaces[c] = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
+                SDL_FreeSurface(surf);
+                if (surfaces[c])
+                    SDL_SetSurfaceBlendMode(surfaces[c], SDL_BLENDMODE_NONE);
+            }
+
+            ShelfPacker packer(PAGE_SIZE, PAGE_SIZE);
+            for (int c = FIRST_GLYPH; c < GLYPH_COUNT; ++c)
+            {
+                SDL_Surface *surf = surfaces[c];
+                if (!surf)
+                    continue;
+                SDL_Rect r;
+                if (!packer.Insert(surf->w + 1, surf->h + 1, r))
+                {
+                    Debug::Error("GlyphAtlas: page full, glyph " + std::to_string(c) + " skipped");
+                    SDL_FreeSurface(surf);
+                    surfaces[c] = nullptr;
+                    continue;
+                }
+                glyphs[c].src = {r.x, r.y, surf->w, surf->h};
+            }
+
+            SDL_Surface *page = SDL_CreateRGBSurfaceWithFormat(0, PAGE_SIZE, std::max(1, packer.UsedHeight()), 32, SDL_PIXELFORMAT_RGBA32);
+            if (page)
+            {
+                SDL_FillRect(page, nullptr, 0);
+                for (int c = FIRST_GLYPH; c < GLYPH_COUNT; ++c)
+                {
+                    if (surfaces[c])
+                    {
+                        SDL_Rect dst = glyphs[c].src;
+                        SDL_BlitSurface(surfaces[c], nullptr, page, &dst);
+                    }
+                }
+                SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, page);
+                SDL_FreeSurface(page);
+                if (tex)
+                {
+                    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+                    char key[64];
+                    SDL_snprintf(key, sizeof(key), "glyphs:%p", static_cast<void *>(font));
+                    texture = TextureCache::Instance().Insert(key, tex);
+                }
+            }
+            for (SDL_Surface *surf : surfaces)
+            {
+                if (surf)
+                    SDL_FreeSurface(surf);
+            }
+        }
+
+        // dispose les glyphes d'une chaîne UTF-8 ; les caractères hors Latin-1 deviennent '?'
+        void BuildLayout(const std::string &text, Layout &out) const
+        {
+            out.quads.clear();
+            out.height = lineHeight;
+            int penX = 0;
+            for (size_t i = 0; i < text.size();)
+            {
+                unsigned char b = static_cast<unsigned char>(text[i]);
+                int c = '?';
+                if (b < 0x80)
+                {
+                    c = b;
+                    i += 1;
+                }
+                else if ((b & 0xE0) == 0xC0 && i + 1 < text.size())
+                {
+                    int cp = ((b & 0x1F) << 6) | (static_cast<unsigned char>(text[i + 1]) & 0x3F);
+                    c = cp < GLYPH_COUNT ? cp : '?';
+                    i += 2;
+                }
+                else
+                {
+                    // séquence plus longue : on saute les octets de continuation
+                    i += 1;
+                    while (i < text.size() && (static_cast<unsigned char>(text[i]) & 0xC0) == 0x80)
+                        ++i;
+                }
+
+                const Glyph &g = glyphs[glyphs[c].present ? c : '?'];
+                if (g.src.w > 0)
+                {
+                    out.quads.push_back({g.src, {static_cast<float>(penX), 0.0f,
+                                                 static_cast<float>(g.src.w), static_cast<float>(g.src.h)}});
+                }
+                penX += g.advance;
+            }
+            out.width = penX;
+        }
+
+        // mise en page mémorisée pour les textes qui ne changent pas
+        const Layout &StaticLayout(const std::string &text)
+        {
+            auto it = staticLayouts.find(text);
+            if (it != staticLayouts.end())
+                return it->second;
+
+            if (staticLayouts.size() >= MAX_STATIC_STRINGS)
+                staticLayouts.clear();
+            Layout &layout = staticLayouts[text];
+            BuildLayout(text, layout);
+            return layout;
+        }
+
+        const TextureHandle &GetTexture() const
+        {
+            return texture;
+        }
+
+    private:
+        static constexpr int FIRST_GLYPH = 32;
+        static constexpr int GLYPH_COUNT = 256;
+        static constexpr int PAGE_SIZE = 1024;
+        static constexpr size_t MAX_STATIC_STRINGS = 256;
+
+        struct Glyph
+        {
+            SDL_Rect src{0, 0, 0, 0};
+            int advance = 0;
+            bool present = false;
+        };
+
+        Glyph glyphs[GLYPH_COUNT];
+        int lineHeight = 0;
+        TextureHandle texture;
+        std::unordered_map<std::string, Layout> staticLayouts;
+    };
+
+    // un atlas par police ouverte (TTF_Font porte déjà la taille)
+    inline GlyphAtlas &GetGlyphAtlas(SDL_Renderer *renderer, TTF_Font *font)
+    {
+        static std::unordered_map<TTF_Font *, std::unique_ptr<GlyphAtlas>> atlases;
+        auto &atlas = atlases[font];
+        if (!atlas)
+            atlas = std::make_unique<GlyphAtlas>(renderer, font);
+        return *atlas;
+    }
+
+    // position du coin haut-gauche du texte selon l'ancre sur la fenêtre et le pivot du texte
+    inline SDL_Point AnchorPosition(SDL_Renderer *renderer,
+                                    int textW,
+                                    int textH,
+                                    int AnchorPointx,
+                                    int AnchorPointy,
+                                    Anchor anchorBase,
+                                    Anchor pivotPoint)
     {
-        SDL_Surface* surf = TTF_RenderText_Blended(font, text.c_str(), color);
-        SDL_Texture* tex  = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
-    
-        int textW, textH;
-        SDL_QueryTexture(tex, nullptr, nullptr, &textW, &textH);
-    
         int winW, winH;
         SDL_GetRendererOutputSize(renderer, &winW, &winH);
     
@@ -79,15 +242,67 @@ namespace Text
             case BOTTOM_MIDDLE: pivotOffX = textW/2; pivotOffY = textH;   break;
             case BOTTOM_RIGHT:  pivotOffX = textW;   pivotOffY = textH;   break;
         }
-    
-        SDL_Rect dst;
-        dst.x = anchorX - pivotOffX;
-        dst.y = anchorY - pivotOffY;
-        dst.w = textW;
-        dst.h = textH;
-    
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_DestroyTexture(tex);
-    }    
-}
+        return {anchorX - pivotOffX, anchorY - pivotOffY};
+    }
 
+    inline void DrawLayout(SDL_Renderer *renderer, const GlyphAtlas &atlas, const GlyphAtlas::Layout &layout,
+                           const SDL_Point &origin, SDL_Color color)
+    {
+        const TextureHandle &texture = atlas.GetTexture();
+        if (!texture)
+            return;
+        for (const GlyphAtlas::GlyphQuad &quad : layout.quads)
+        {
+            SDL_FRect dst = quad.dst;
+            dst.x += origin.x;
+            dst.y += origin.y;
+            SpriteBatch::Instance().Draw(renderer, texture->sdl, texture->width, texture->height, quad.src, dst, 0.0f, color);
+        }
+    }
+
+    /**
+     * Affiche du texte positionné selon un point d'ancrage et un pivot.
+     * Aucun rendu TTF ni création de texture : les glyphes viennent de l'atlas de la police.
+     *
+     * @param renderer       SDL_Renderer*
+     * @param font           TTF_Font* (déjà chargé)
+     * @param text           std::string, le texte à afficher
+     * @param AnchorPointx   int, offset en X depuis l'ancre
+     * @param AnchorPointy   int, offset en Y depuis l'ancre
+     * @param anchorBase     Anchor, point d'ancrage sur la fenêtre
+     * @param pivotPoint     Anchor, point pivot du texte
+     * @param color          SDL_Color (par défaut blanc)
+     */
+    inline void WriteText(SDL_Renderer* renderer,
+                          TTF_Font*      font,
+                          const std::string& text,
+                          int AnchorPointx,
+                          int AnchorPointy,
+                          Anchor anchorBase,
+                          Anchor pivotPoint,
+                          SDL_Color color = {255,255,255,255})
+    {
+        static GlyphAtlas::Layout layout; // tampon réutilisé d'un appel à l'autre
+
+        GlyphAtlas &atlas = GetGlyphAtlas(renderer, font);
+        atlas.BuildLayout(text, layout);
+        SDL_Point origin = AnchorPosition(renderer, layout.width, layout.height, AnchorPointx, AnchorPointy, anchorBase, pivotPoint);
+        DrawLayout(renderer, atlas, layout, origin, color);
+    }
+
+    // comme WriteText, pour un texte fixe : la mise en page est gardée en cache selon son contenu
+    inline void WriteStaticText(SDL_Renderer* renderer,
+                                TTF_Font*      font,
+                                const std::string& text,
+                                int AnchorPointx,
+                                int AnchorPointy,
+                                Anchor anchorBase,
+                                Anchor pivotPoint,
+                                SDL_Color color = {255,255,255,255})
+    {
+        GlyphAtlas &atlas = GetGlyphAtlas(renderer, font);
+        const GlyphAtlas::Layout &layout = atlas.StaticLayout(text);
+        SDL_Point origin = AnchorPosition(renderer, layout.width, layout.height, AnchorPointx, AnchorPointy, anchorBase, pivotPoint);
+        DrawLayout(renderer, atlas, layout, origin, color);
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * Texture partagée : la taille est lue une seule fois au chargement.
+ */
+struct Texture
+{
+    SDL_Texture *sdl = nullptr;
+    int width = 0;
+    int height = 0;
+    std::string path;
+};
+
+// handle à compteur de références : la texture est libérée avec le dernier handle
+using TextureHandle = std::shared_ptr<Texture>;
+
+class TextureCache
+{
+public:
+    struct Stats
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t texturesResident = 0;
+        size_t bytesResident = 0;
+    };
+
+    static TextureCache &Instance()
+    {
+        // jamais détruit : des handles peuvent encore être libérés par la scène à la fermeture
+        static TextureCache *instance = new TextureCache();
+        return *instance;
+    }
+
+    // charge une texture (chemin depuis le dossier du jeu) ou renvoie celle déjà en mémoire
+    TextureHandle Load(SDL_Renderer *renderer, const std::string &path)
+    {
+        auto it = entries.find(path);
+        if (it != entries.end())
+        {
+            if (TextureHandle handle = it->second.lock())
+            {
+                ++stats.hits;
+                return handle;
+            }
+        }
+        ++stats.misses;
+
+        SDL_Texture *tex = IMG_LoadTexture_RW(renderer, AssetPack::Instance().OpenRW(path), 1);
+        if (!tex)
+        {
+            Debug::Error("TextureCache: IMG_LoadTexture failed for " + path + ": " + IMG_GetError());
+            return nullptr;
+        }
+        return Insert(path, tex);
+    }
+
+    // texture déjà en mémoire, sans la charger ni compter de hit
+    TextureHandle Find(const std::string &path) const
+    {
+        auto it = entries.find(path);
+        return it != entries.end() ? it->second.lock() : nullptr;
+    }
+
+    // enregistre une texture déjà créée sous une clé donnée
+    TextureHandle Insert(const std::string &key, SDL_Texture *tex)
+    {
+        Texture *texture = new Texture();
+        texture->sdl = tex;
+        texture->path = key;
+        SDL_QueryTexture(tex, nullptr, nullptr, &texture->width, &texture->height);
+
+        stats.bytesResident += Bytes(*texture);
+        ++stats.texturesResident;
+
+        TextureHandle handle(texture, [this](Texture *t)
+        {
+            Release(t);
+        });
+        entries[key] = handle;
+        return handle;
+    }
+
+    /**
+     * Recharge depuis le disque une texture en mémoire (rechargement à chaud) : le Texture partagé est modifié sur place,
+     * tous les handles voient la nouvelle image. Faux si la texture n'est pas chargée.
+     */
+    bool Reload(SDL_Renderer *renderer, const std::string &path)
+    {
+        TextureHandle handle = Find(path);
+        if (!handle)
+            return false;
+
+        SDL_Texture *tex = IMG_LoadTexture_RW(renderer, AssetPack::Instance().OpenRW(path), 1);
+        if (!tex)
+        {
+            Debug::Error("TextureCache: reload failed for " + path + ": " + IMG_GetError());
+            return true;
+        }
+
+        int width = handle->width, height = handle->height;
+        stats.bytesResident -= Bytes(*handle);
+        SDL_DestroyTexture(handle->sdl);
+        handle->sdl = tex;
+        SDL_QueryTexture(tex, nullptr, nullptr, &handle->width, &handle->height);
+        stats.bytesResident += Bytes(*handle);
+
+        // les SpriteFrame gardent leur rectangle source
+        if (handle->width != width || handle->height != height)
+            Debug::Error("TextureCache: " + path + " changed size, frames using it keep the old one until reloaded");
+        return true;
+    }
+
+    const Stats &GetStats() const
+    {
+        return stats;
+    }
+
+    void LogStats() const
+    {
+        Debug::Log("TextureCache: " + std::to_string(stats.texturesResident) + " textures, " +
+                   std::to_string(stats.bytesResident / (1024 * 1024)) + " Mo, " +
+                   std::to_string(stats.hits) + " hits, " +
+                   std::to_string(stats.misses) + " misses");
+    }
+
+private:
+    TextureCache() = default;
+
+    static size_t Bytes(const Texture &texture)
+    {
+        return static_cast<size_t>(texture.width) * texture.height * 4;
+    }
+
+    void Release(Texture *texture)
+    {
+        auto it = entries.find(texture->path);
+        if (it != entries.end() && it->second.expired())
+        {
+            entries.erase(it);
+        }
+        if (texture->sdl)
+        {
+            SDL_DestroyTexture(texture->sdl);
+        }
+        stats.bytesResident -= Bytes(*texture);
+        --stats.texturesResident;
+        delete texture;
+    }
+
+    std::unordered_map<std::string, std::weak_ptr<Texture>> entries;
+    Stats stats;
+};
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+/**
+ * Lecture d'une cinématique en flux : un thread décode les frames à venir dans un anneau de surfaces
+ * de taille fixe, le thread principal les envoie dans deux textures streaming au moment de les afficher.
+ * La mémoire dépend de la taille de l'anneau, pas de la longueur du clip.
+ * Si un fichier <dossier du clip>.cin existe (voir cinematic_converter.py), il remplace les PNG.
+ */
+class VideoStream
+{
+public:
+    struct Clip
+    {
+        std::string id;
+        std::vector<std::string> paths;
+        float frameDuration;
+        std::shared_ptr<CinematicFile> cinematic; // renseigné par SetClips si le .cin est présent
+    };
+
+    VideoStream(SDL_Renderer *renderer, std::string mainpath, size_t ringSize = VIDEO_RING_SIZE)
+        : renderer_(renderer), mainPath(std::move(mainpath)), slots(ringSize)
+    {
+        worker = std::thread(&VideoStream::DecodeLoop, this);
+    }
+
+    ~VideoStream()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        cv.notify_all();
+        worker.join();
+
+        for (Slot &slot : slots)
+        {
+            if (slot.surface)
+                SDL_FreeSurface(slot.surface);
+        }
+    }
+
+    VideoStream(const VideoStream &) = delete;
+    VideoStream &operator=(const VideoStream &) = delete;
+
+    void SetClips(std::vector<Clip> list)
+    {
+        for (Clip &clip : list)
+        {
+            clip.cinematic = OpenCinematic(clip);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        clips = std::move(list);
+        current = -1;
+        decodeClip = -1;
+        ++generation;
+        ClearSlots();
+    }
+
+    /**
+     * Joue le clip ; s'il est déjà en cours il continue, sauf si fromStart est demandé.
+     */
+    bool Play(const std::string &id, bool loop = true, bool fromStart = false)
+    {
+        if (current >= 0 && clips[current].id == id && !fromStart)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            loop_ = loop;
+            decodeLoop = loop;
+            cv.notify_all();
+            return true;
+        }
+        for (size_t i = 0; i < clips.size(); ++i)
+        {
+            if (clips[i].id == id)
+            {
+                Restart(static_cast<int>(i), loop);
+                return true;
+            }
+        }
+        Debug::Error("VideoStream: clip '" + id + "' not found");
+        return false;
+    }
+
+    // avance la lecture et renvoie la frame à afficher (la précédente si le décodage est en retard)
+    const SpriteFrame *NextFrame(float deltaTime)
+    {
+        if (current < 0)
+            return nullptr;
+
+        const Clip &clip = clips[current];
+        size_t count = clip.paths.size();
+        if (count == 0)
+            return nullptr;
+
+        timer += deltaTime;
+        if (timer >= clip.frameDuration)
+        {
+            size_t steps = static_cast<size_t>(timer / clip.frameDuration);
+            timer -= steps * clip.frameDuration;
+            playSeq += steps;
+            if (!loop_ && playSeq >= count)
+                playSeq = count - 1;
+        }
+
+        if (static_cast<long long>(playSeq) != uploadedSeq)
+            Upload();
+
+        return shown.texture ? &shown : nullptr;
+    }
+
+    bool Finished() const
+    {
+        return current >= 0 && playSeq == clips[current].paths.size() - 1;
+    }
+
+    float EntryTime() const
+    {
+        return current >= 0 ? clips[current].frameDuration * clips[current].paths.size() : 0.0f;
+    }
+
+    const std::string &CurrentId() const
+    {
+        static std::string empty;
+        return current >= 0 ? clips[current].id : empty;
+    }
+
+private:
+    static constexpr int TEXTURE_COUNT = 2;
+    static constexpr std::chrono::milliseconds FIRST_FRAME_TIMEOUT{100};
+
+    // frame décodée, identifiée par son rang depuis le début du clip (les boucles continuent de compter)
+    struct Slot
+    {
+        SDL_Surface *surface = nullptr;
+        size_t seq = 0;
+        bool reserved = false;
+    };
+
+    void Restart(int clip, bool loop)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        current = clip;
+        loop_ = loop;
+        timer = 0.0f;
+        playSeq = 0;
+        uploadedSeq = -1;
+
+        decodeClip = clip;
+        decodeSeq = 0;
+        decodeLoop = loop;
+        ClearSlots();
+        cv.notify_all();
+    }
+
+    void ClearSlots()
+    {
+        for (Slot &slot : slots)
+        {
+            if (slot.surface)
+                SDL_FreeSurface(slot.surface);
+            slot = Slot();
+        }
+    }
+
+    size_t FrameOf(size_t seq) const
+    {
+        size_t count = clips[decodeClip].paths.size();
+        return decodeLoop ? seq % count : std::min(seq, count - 1);
+    }
+
+    bool CanDecode() const
+    {
+        if (decodeClip < 0 || clips[decodeClip].paths.empty())
+            return false;
+        if (!decodeLoop && decodeSeq >= clips[decodeClip].paths.size())
+            return false;
+        for (const Slot &slot : slots)
+        {
+            if (!slot.reserved)
+                return true;
+        }
+        return false;
+    }
+
+    void DecodeLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [this] { return quit || CanDecode(); });
+            if (quit)
+                break;
+
+            Slot *slot = nullptr;
+            for (Slot &s : slots)
+            {
+                if (!s.reserved)
+                {
+                    slot = &s;
+                    break;
+                }
+            }
+            slot->reserved = true;
+            slot->seq = decodeSeq++;
+            unsigned gen = generation;
+            size_t frame = FrameOf(slot->seq);
+            std::string path = "Assets/" + mainPath + clips[decodeClip].paths[frame];
+            std::shared_ptr<CinematicFile> cinematic = clips[decodeClip].cinematic;
+
+            lock.unlock();
+            SDL_Surface *surface = cinematic ? Decode(*cinematic, static_cast<int>(frame)) : Decode(path);
+            lock.lock();
+
+            if (gen != generation)
+            {
+                // le clip a changé pendant le décodage : la case a déjà été vidée
+                if (surface)
+                    SDL_FreeSurface(surface);
+                continue;
+            }
+            slot->surface = surface;
+            if (!surface)
+                slot->reserved = false;
+            cv.notify_all();
+        }
+    }
+
+    static SDL_Surface *Decode(const std::string &path)
+    {
+        SDL_Surface *surf = IMG_Load_RW(AssetPack::Instance().OpenRW(path), 1);
+        if (!surf)
+        {
+            Debug::Error("VideoStream: IMG_Load failed for " + path + ": " + IMG_GetError());
+            return nullptr;
+        }
+        SDL_Surface *rgba = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(surf);
+        return rgba;
+    }
+
+    static SDL_Surface *Decode(CinematicFile &cinematic, int frame)
+    {
+        SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, cinematic.Width(), cinematic.Height(), 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surface)
+            return nullptr;
+        if (!cinematic.Decode(frame, static_cast<uint8_t *>(surface->pixels), surface->pitch))
+        {
+            Debug::Error("VideoStream: failed to decode cinematic frame " + std::to_string(frame));
+            SDL_FreeSurface(surface);
+            return nullptr;
+        }
+        return surface;
+    }
+
+    // <dossier du clip>.cin, utilisé seulement s'il a le bon nombre de frames
+    std::shared_ptr<CinematicFile> OpenCinematic(const Clip &clip) const
+    {
+        if (clip.paths.empty())
+            return nullptr;
+        size_t slash = clip.paths.front().find_last_of('/');
+        if (slash == std::string::npos)
+            return nullptr;
+
+        std::string path = "Assets/" + mainPath + clip.paths.front().substr(0, slash) + ".cin";
+        if (!AssetPack::Instance().Exists(path))
+            return nullptr;
+
+        auto cinematic = std::make_shared<CinematicFile>();
+        if (!cinematic->Open(path))
+            return nullptr;
+        if (cinematic->FrameCount() != static_cast<int>(clip.paths.size()))
+        {
+            Debug::Error("VideoStream: " + path + " has " + std::to_string(cinematic->FrameCount()) +
+                         " frames, expected " + std::to_string(clip.paths.size()) + ", using PNG frames");
+            return nullptr;
+        }
+        Debug::Log("VideoStream: streaming '" + clip.id + "' from " + path);
+        return cinematic;
+    }
+
+    void Upload()
+    {
+        SDL_Surface *surface = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            // le décodage est en retard : il reprend à la frame affichée
+            if (decodeSeq < playSeq)
+                decodeSeq = playSeq;
+
+            auto ready = [this]
+            {
+                for (const Slot &slot : slots)
+                {
+                    if (slot.surface && slot.seq == playSeq)
+                        return true;
+                }
+                return false;
+            };
+            // la première frame d'un clip est attendue, ensuite on garde la précédente
+            if (uploadedSeq < 0)
+                cv.wait_for(lock, FIRST_FRAME_TIMEOUT, ready);
+
+            for (Slot &slot : slots)
+            {
+                if (!slot.reserved || !slot.surface)
+                    continue;
+                if (slot.seq == playSeq)
+                {
+                    surface = slot.surface;
+                    slot = Slot();
+                }
+                else if (slot.seq < playSeq)
+                {
+                    // frame sautée
+                    SDL_FreeSurface(slot.surface);
+                    slot = Slot();
+                }
+            }
+            cv.notify_all();
+        }
+
+        if (!surface)
+            return;
+
+        TextureHandle &target = textures[nextTexture];
+        if (!target || target->width != surface->w || target->height != surface->h)
+        {
+            SDL_Texture *tex = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, surface->w, surface->h);
+            if (!tex)
+            {
+                Debug::Error("VideoStream: SDL_CreateTexture failed: " + std::string(SDL_GetError()));
+                SDL_FreeSurface(surface);
+                return;
+            }
+            SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+            char key[64];
+            SDL_snprintf(key, sizeof(key), "video:%p#%d", static_cast<void *>(this), nextTexture);
+            target = TextureCache::Instance().Insert(key, tex);
+        }
+        SDL_UpdateTexture(target->sdl, nullptr, surface->pixels, surface->pitch);
+        SDL_FreeSurface(surface);
+
+        shown.texture = target;
+        shown.src = {0, 0, target->width, target->height};
+        uploadedSeq = static_cast<long long>(playSeq);
+        nextTexture = (nextTexture + 1) % TEXTURE_COUNT;
+    }
+
+    SDL_Renderer *renderer_;
+    std::string mainPath;
+    std::vector<Clip> clips;
+
+    // lecture (thread principal)
+    int current = -1;
+    bool loop_ = true;
+    float timer = 0.0f;
+    size_t playSeq = 0;
+    long long uploadedSeq = -1;
+    TextureHandle textures[TEXTURE_COUNT];
+    int nextTexture = 0;
+    SpriteFrame shown;
+
+    // décodage (protégé par mutex)
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Slot> slots;
+    unsigned generation = 0;
+    int decodeClip = -1;
+    size_t decodeSeq = 0;
+    bool decodeLoop = true;
+    bool quit = false;
+
+    std::thread worker;
+};
@@ -0,0 +1,79 @@
+"""
+Regroupe les fichiers de Assets/ dans une archive unique, projetée en mémoire par le jeu (utilities_pack.h).
+Les fichiers sont stockés tels quels (PNG, MP3, JSON et .cin sont déjà compressés ou petits).
+
+Format (little-endian) :
+    en-tête : "RPAK", u32 version, u32 nombre de fichiers, u32 taille de la table
+    table   : pour chaque fichier, u64 offset, u64 taille, u16 longueur du chemin, chemin UTF-8
+              (relatif au dossier du jeu, séparateur '/', ex. "Assets/MC/mc_idle.png")
+    données : chaque fichier commence sur un multiple de 16 octets
+
+Usage :
+    python3 asset_packer.py                         # Assets/ -> Assets.pak
+    python3 asset_packer.py Assets -o Assets.pak [--exclude .wav]
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"RPAK"
+VERSION = 1
+ALIGNMENT = 16
+HEADER_SIZE = 16
+
+
+def collect(root, excluded):
+    files = []
+    for folder, dirs, names in os.walk(root):
+        dirs.sort()
+        for name in sorted(names):
+            if name.endswith(".pak") or any(name.lower().endswith(ext) for ext in excluded):
+                continue
+            path = os.path.join(folder, name)
+            files.append(os.path.normpath(path).replace(os.sep, "/"))
+    return files
+
+
+def pack(root, output, excluded):
+    files = collect(root, excluded)
+    if not files:
+        sys.exit(f"{root} : aucun fichier à regrouper")
+
+    table_size = sum(8 + 8 + 2 + len(p.encode("utf-8")) for p in files)
+    offset = HEADER_SIZE + table_size
+    entries = []
+    for path in files:
+        offset = (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+        size = os.path.getsize(path)
+        entries.append((path, offset, size))
+        offset += size
+
+    with open(output, "wb") as out:
+        out.write(MAGIC + struct.pack("<III", VERSION, len(entries), table_size))
+        for path, offset, size in entries:
+            encoded = path.encode("utf-8")
+            out.write(struct.pack("<QQH", offset, size, len(encoded)) + encoded)
+        for n, (path, offset, size) in enumerate(entries):
+            out.write(b"\0" * (offset - out.tell()))
+            with open(path, "rb") as f:
+                out.write(f.read())
+            print(f"\r{output} : {n + 1}/{len(entries)}", end="", flush=True)
+        total = out.tell()
+
+    print(f"\r{output} : {len(entries)} fichiers, {total / 1e6:.1f} Mo")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Regroupe les ressources du jeu dans une archive .pak")
+    parser.add_argument("root", nargs="?", default="Assets", help="dossier à regrouper (par défaut : Assets)")
+    parser.add_argument("-o", "--output", default="Assets.pak", help="archive produite (par défaut : Assets.pak)")
+    parser.add_argument("--exclude", action="append", default=[], help="extension à ignorer, répétable")
+    args = parser.parse_args()
+
+    pack(args.root.rstrip("/"), args.output, [e.lower() for e in args.exclude])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,72 @@
+"""
+Découpe un grand monde en morceaux chargés pendant la partie (utilities_chunks.h) :
+une image de fond (1 pixel = 1 case) et une hitbox JSON aux mêmes coordonnées donnent, pour chaque morceau de
+N x N cases, "chunk_<x>_<y>.png" et "chunk_<x>_<y>.lvl" (voir level_compiler.py).
+Le morceau (0, 0) commence au coin haut gauche de l'image, qui est aussi la position du niveau dans le jeu.
+
+Usage :
+    python3 chunk_builder.py monde.png monde.json -o Assets/Levels/World/Chunks/ [--cells 100]
+
+Le manifeste (Assets/Levels/levels.json) décrit ensuite le niveau avec l'entrée affichée à la fin :
+    "chunks": {"folder": "Chunks/", "cells": 100, "min": [0, 0], "max": [X, Y]}
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from PIL import Image
+
+from level_compiler import compile_rects
+
+
+def clip(rect, x0, y0, size):
+    # rectangle ramené dans le morceau dont le coin est (x0, y0), None s'il ne le touche pas
+    x, y, w, h = rect
+    left, top = max(x, x0), max(y, y0)
+    right, bottom = min(x + w, x0 + size), min(y + h, y0 + size)
+    if right <= left or bottom <= top:
+        return None
+    return (left - x0, top - y0, right - left, bottom - top)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Découpe une image et une hitbox en morceaux de monde")
+    parser.add_argument("image", help="image de fond du monde entier (1 pixel = 1 case)")
+    parser.add_argument("hitbox", help="hitbox JSON du monde entier, en cases")
+    parser.add_argument("-o", "--output", required=True, help="dossier des morceaux produits")
+    parser.add_argument("--cells", type=int, default=100, help="cases par côté d'un morceau (par défaut : 100)")
+    args = parser.parse_args()
+
+    with open(args.hitbox, encoding="utf-8") as f:
+        items = json.load(f)
+    if not isinstance(items, list):
+        sys.exit(f"{args.hitbox} : attendu un tableau de rectangles")
+    rects = [(int(r["x"]), int(r["y"]), int(r["width"]), int(r["height"])) for r in items]
+
+    image = Image.open(args.image).convert("RGBA")
+    size = args.cells
+    countX = (image.width + size - 1) // size
+    countY = (image.height + size - 1) // size
+    os.makedirs(args.output, exist_ok=True)
+
+    for cy in range(countY):
+        for cx in range(countX):
+            x0, y0 = cx * size, cy * size
+            # le bord du monde qui ne remplit pas un morceau reste transparent
+            tile = Image.new("RGBA", (size, size))
+            tile.paste(image.crop((x0, y0, min(x0 + size, image.width), min(y0 + size, image.height))), (0, 0))
+            base = os.path.join(args.output, f"chunk_{cx}_{cy}")
+            tile.save(base + ".png")
+
+            local = [r for r in (clip(rect, x0, y0, size) for rect in rects) if r is not None]
+            compile_rects(local, base + ".lvl", size)
+
+    entry = {"folder": "<dossier relatif au niveau>", "cells": size, "min": [0, 0], "max": [countX - 1, countY - 1]}
+    print(f"{countX * countY} morceaux ; entrée du manifeste :")
+    print('"chunks": ' + json.dumps(entry))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,264 @@
+"""
+Convertit une séquence de frames PNG (un dossier par clip) en fichier .cin, sans perte :
+images clés et frames delta, pixels RGBA codés par des opérations à la QOI puis compressés par un LZ simple.
+Dans une frame delta, les pixels identiques à la frame précédente ne sont pas recodés (opération SKIP).
+
+Format (little-endian) :
+    en-tête   : "RCIN", u16 version, u16 réservé (0), u32 largeur, u32 hauteur,
+                u32 nombre de frames, u32 intervalle des images clés
+    table     : u32 offset de chaque frame, puis u32 fin du fichier
+    frame     : u8 type (0 = image clé, 1 = delta), u32 taille des opérations, puis leur bloc LZ
+
+Opérations, pixel après pixel ligne par ligne ; pixel courant noir opaque et table des 64 couleurs vues remise à zéro
+à chaque frame, comme QOI (même hachage r * 3 + g * 5 + b * 7 + a * 11) :
+    00iiiiii            INDEX : couleur de la table
+    01rrggbb            DIFF  : écarts de -2 à 1 sur r, g, b par rapport au pixel courant
+    10gggggg rrrrbbbb   LUMA  : écart de -32 à 31 sur g, écarts r - g et b - g de -8 à 7
+    11llllll            RUN   : pixel courant répété 1 à 60 fois (0xC0 à 0xFB)
+    0xFC varint         SKIP  : pixels repris de la frame précédente (delta seulement), le dernier devient le pixel courant
+    0xFE r g b          RGB
+    0xFF r g b a        RGBA
+
+Bloc LZ (même principe que LZ4) : séquences [jeton][littéraux][offset u16][longueur],
+le jeton porte la longueur des littéraux (4 bits hauts) et celle de la copie - 4 (4 bits bas),
+15 signifie que la longueur continue sur les octets suivants (255 = continuer).
+La dernière séquence ne contient que des littéraux.
+
+Un .cin n'est écrit que s'il est plus petit que les PNG du clip (sinon le jeu garde les PNG), sauf avec --force.
+Mesuré sur les clips du jeu (1920x1080, décodage identique à l'octet près à celui de libpng, -O2) :
+    clip        frames   PNG        .cin       décodage .cin   libpng
+    boss        16       4.80 Mo    7.48 Mo    7.6 ms          12.2 ms
+    bosskill    34       1.23 Mo    0.79 Mo    1.6 ms           7.8 ms
+    endkill     40       6.66 Mo    9.27 Mo    4.5 ms          10.0 ms
+    start       42      13.61 Mo   21.62 Mo    9.2 ms          13.2 ms
+    loop        22       7.72 Mo   11.94 Mo   11.0 ms          16.4 ms
+Objectif de taille non atteint sauf pour bosskill : les frames sont tramées avec une palette propre à chaque image,
+les pixels inchangés sont dispersés et deflate reste plus efficace que des opérations décodables aussi vite.
+Seul bosskill.cin est donc écrit ; les autres clips restent en PNG.
+
+Usage :
+    python3 cinematic_converter.py                      # tous les clips de Assets/EndVideo et Assets/MainMenu
+    python3 cinematic_converter.py Assets/EndVideo/endkill [--key 30] [--force]
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+from array import array
+from PIL import Image, ImageChops
+
+MAGIC = b"RCIN"
+VERSION = 3
+DEFAULT_KEY_INTERVAL = 30
+DEFAULT_FOLDERS = ["Assets/EndVideo", "Assets/MainMenu"]
+
+MIN_MATCH = 4
+MAX_OFFSET = 65535
+END_LITERALS = 12  # les derniers octets sont toujours des littéraux
+
+OP_RUN = 0xC0
+OP_SKIP = 0xFC
+OP_RGB = 0xFE
+OP_RGBA = 0xFF
+MAX_RUN = 60
+
+
+def write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz_compress(src):
+    n = len(src)
+    out = bytearray()
+    table = {}
+    anchor = 0
+    i = 0
+    limit = n - END_LITERALS
+    while i < limit:
+        key = src[i:i + MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = i
+        if candidate is None or i - candidate > MAX_OFFSET:
+            i += 1
+            continue
+
+        match = MIN_MATCH
+        while i + match < n - 5 and src[candidate + match] == src[i + match]:
+            match += 1
+
+        literals = i - anchor
+        out.append((min(literals, 15) << 4) | min(match - MIN_MATCH, 15))
+        if literals >= 15:
+            write_length(out, literals - 15)
+        out += src[anchor:i]
+        out += struct.pack("<H", i - candidate)
+        if match - MIN_MATCH >= 15:
+            write_length(out, match - MIN_MATCH - 15)
+        i += match
+        anchor = i
+
+    literals = n - anchor
+    out.append(min(literals, 15) << 4)
+    if literals >= 15:
+        write_length(out, literals - 15)
+    out += src[anchor:]
+    return bytes(out)
+
+
+def write_varint(out, value):
+    while value >= 128:
+        out.append(0x80 | (value & 127))
+        value >>= 7
+    out.append(value)
+
+
+def changed_mask(img, previous):
+    """Un octet par pixel, nul si le pixel est identique dans la frame précédente."""
+    diff = ImageChops.difference(img, previous).split()
+    mask = ImageChops.lighter(ImageChops.lighter(diff[0], diff[1]), ImageChops.lighter(diff[2], diff[3]))
+    return mask.tobytes()
+
+
+def encode_pixels(pixels, mask):
+    """Opérations d'une frame ; pixels en mots RGBA (r dans l'octet bas), mask None pour une image clé."""
+    out = bytearray()
+    append = out.append
+    index = [0] * 64
+    px = 0xFF000000
+    run = 0
+
+    # seuls les segments de pixels modifiés sont parcourus en Python, les autres deviennent des SKIP
+    segments = [(0, len(pixels))] if mask is None else [m.span() for m in re.finditer(rb"[^\x00]+", mask)]
+    pos = 0
+    for start, end in segments + [(len(pixels), len(pixels))]:
+        if start > pos:
+            while run:
+                count = min(run, MAX_RUN)
+                append(OP_RUN | (count - 1))
+                run -= count
+            append(OP_SKIP)
+            write_varint(out, start - pos)
+            px = pixels[start - 1]
+
+        for i in range(start, end):
+            p = pixels[i]
+            if p == px:
+                run += 1
+                if run == MAX_RUN:
+                    append(OP_RUN | (MAX_RUN - 1))
+                    run = 0
+                continue
+            if run:
+                append(OP_RUN | (run - 1))
+                run = 0
+
+            r, g, b, a = p & 255, (p >> 8) & 255, (p >> 16) & 255, p >> 24
+            h = (r * 3 + g * 5 + b * 7 + a * 11) % 64
+            if index[h] == p:
+                append(h)
+            else:
+                index[h] = p
+                if a == px >> 24:
+                    dr = ((r - (px & 255) + 128) & 255) - 128
+                    dg = ((g - ((px >> 8) & 255) + 128) & 255) - 128
+                    db = ((b - ((px >> 16) & 255) + 128) & 255) - 128
+                    if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                        append(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+                    elif -32 <= dg <= 31 and -8 <= dr - dg <= 7 and -8 <= db - dg <= 7:
+                        append(0x80 | (dg + 32))
+                        append(((dr - dg + 8) << 4) | (db - dg + 8))
+                    else:
+                        out += bytes((OP_RGB, r, g, b))
+                else:
+                    out += bytes((OP_RGBA, r, g, b, a))
+            px = p
+        pos = max(pos, end)
+
+    while run:
+        count = min(run, MAX_RUN)
+        append(OP_RUN | (count - 1))
+        run -= count
+    return bytes(out)
+
+
+def convert(folder, output, key_interval, force):
+    paths = sorted(p for p in os.listdir(folder) if p.lower().endswith(".png"))
+    if not paths:
+        print(f"{folder} : aucune frame PNG")
+        return
+
+    width = height = 0
+    frames_data = []
+    previous = None
+    png_size = 0
+    for n, name in enumerate(paths):
+        path = os.path.join(folder, name)
+        png_size += os.path.getsize(path)
+        img = Image.open(path).convert("RGBA")
+        if n == 0:
+            width, height = img.size
+        elif img.size != (width, height):
+            sys.exit(f"{path} : taille {img.size} différente de la première frame {(width, height)}")
+
+        pixels = array("I", img.tobytes())
+        if sys.byteorder != "little":
+            pixels.byteswap()
+        key = previous is None or n % key_interval == 0
+        ops = encode_pixels(pixels, None if key else changed_mask(img, previous))
+
+        out = bytearray()
+        out.append(0 if key else 1)
+        out += struct.pack("<I", len(ops))
+        out += lz_compress(ops)
+        frames_data.append(bytes(out))
+        previous = img
+        print(f"\r{folder} : {n + 1}/{len(paths)}", end="", flush=True)
+
+    header = MAGIC + struct.pack("<HHIIII", VERSION, 0, width, height, len(frames_data), key_interval)
+    offset = len(header) + 4 * (len(frames_data) + 1)
+    table = bytearray()
+    for data in frames_data:
+        table += struct.pack("<I", offset)
+        offset += len(data)
+    table += struct.pack("<I", offset)
+
+    summary = f"\r{folder} : {len(frames_data)} frames, {png_size / 1e6:.2f} Mo en PNG -> {offset / 1e6:.2f} Mo"
+    if offset >= png_size and not force:
+        # un .cin plus gros que les PNG n'apporte rien : le jeu lit les PNG
+        if os.path.exists(output):
+            os.remove(output)
+        print(f"{summary}, plus gros que les PNG : {output} non écrit")
+        return
+
+    with open(output, "wb") as f:
+        f.write(header)
+        f.write(table)
+        for data in frames_data:
+            f.write(data)
+    print(f"{summary} ({output})")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convertit des dossiers de frames PNG en cinématiques .cin")
+    parser.add_argument("folders", nargs="*", help="dossiers de frames (par défaut : tous les clips des cinématiques)")
+    parser.add_argument("--key", type=int, default=DEFAULT_KEY_INTERVAL, help="intervalle entre images clés")
+    parser.add_argument("--force", action="store_true", help="écrit le .cin même s'il est plus gros que les PNG (mesures)")
+    args = parser.parse_args()
+
+    folders = args.folders
+    if not folders:
+        folders = [os.path.join(root, d) for root in DEFAULT_FOLDERS for d in sorted(os.listdir(root))
+                   if os.path.isdir(os.path.join(root, d))]
+
+    for folder in folders:
+        folder = folder.rstrip("/")
+        convert(folder, folder + ".cin", args.key, args.force)
+
+
+if __name__ == "__main__":
+    main()
@@ -18,6 +18,40 @@ static constexpr int ENEMY_TARGET_PLAYER_RANGE = 100000.0f; // la mettre au carr
 static constexpr int ENEMY_ATTACK_PLAYER_RANGE = 22500.0f; // la mettre au carré !!!
 static constexpr float STUCK_TIME = 0.5f;
 
+static constexpr int ENTITY_LAYER = 900; // joueur et ennemis partagent le calque pour être triés selon y
+static constexpr bool Y_SORTED_RENDERING = false; // joueur et ennemis triés selon y à chaque frame, sinon ordre des calques
+static constexpr size_t VIDEO_RING_SIZE = 4; // frames de cinématique décodées à l'avance
+static constexpr bool SHOW_DEBUG_OVERLAY = false; // fps, position et auto-lock en haut de l'écran
+static constexpr const char *ASSET_PACK_PATH = "Assets.pak"; // archive des ressources, fichiers libres si absente
+static constexpr const char *LEVEL_MANIFEST_PATH = "Assets/Levels/levels.json"; // niveaux et prefabs (voir levels.h)
+static constexpr unsigned ASSET_LOADER_THREADS = 4; // threads de décodage, limité au nombre de coeurs - 1
+static constexpr float ASSET_UPLOAD_BUDGET_MS = 4.0f; // envois de textures et créations d'objets par frame
+static constexpr float LEVEL_MEMORY_BUDGET_MB = 8.0f; // niveaux quittés gardés en mémoire tant qu'ils tiennent dans ce budget
+static constexpr bool HOT_RELOAD = false; // développement : Assets/ surveillé, images, hitbox et manifeste repris en jeu (Assets.pak ignoré)
+static constexpr unsigned HOT_RELOAD_DELAY_MS = 200; // un fichier est relu après ce délai sans nouvelle écriture
+static constexpr unsigned HOT_RELOAD_POLL_MS = 1000; // balayage des dates de modification quand inotify manque
+static constexpr bool LEVEL_TILE_COLLISION = false; // décor testé sur la grille du niveau plutôt qu'avec un objet Wall par rectangle (les rayons arrêtés par Flag_Wall lisent alors la grille) ; toujours actif sur un monde en morceaux
+static constexpr float LEVEL_LAYER_TILE_FRACTION = 0.25f; // côté à l'écran des carreaux d'un calque de niveau, en fraction du petit côté de la vue
+static constexpr bool STATIC_LAYER_CACHE = false; // fond et premier plan des niveaux gardés dans une texture cible, redessinés seulement s'ils changent
+static constexpr bool DYNAMIC_RESOLUTION = false; // rendu dans une cible réduite selon la durée des frames, puis étiré sur la fenêtre
+static constexpr float DYNAMIC_RES_TARGET_MS = 1000.0f / 60.0f; // durée de frame visée
+static constexpr float DYNAMIC_RES_TOLERANCE = 0.1f; // marge au-dessus de la cible avant de baisser l'échelle
+static constexpr float DYNAMIC_RES_MIN_SCALE = 0.5f; // échelle la plus basse, par côté
+static constexpr float DYNAMIC_RES_STEP = 0.05f; // cran de l'échelle
+static constexpr float DYNAMIC_RES_SMOOTHING = 0.1f; // poids d'une frame dans la moyenne glissante
+static constexpr float DYNAMIC_RES_DOWN_DELAY = 0.25f; // secondes au moins entre deux baisses
+static constexpr float DYNAMIC_RES_UP_DELAY = 2.0f; // secondes sous la cible avant de tenter une remontée
+static constexpr float DYNAMIC_RES_UP_DELAY_MAX = 16.0f; // attente maximale après des remontées ratées
+static constexpr bool QUALITY_GOVERNOR = false; // IA, chemins, animations et échelle de rendu réduits quand les frames dépassent le budget
+static constexpr float QUALITY_FRAME_BUDGET_MS = 1000.0f / 60.0f; // durée de frame visée
+static constexpr float QUALITY_DEGRADE_MARGIN = 0.15f; // au-dessus de budget x (1 + marge), la qualité baisse
+static constexpr float QUALITY_RESTORE_MARGIN = 0.05f; // en dessous de budget x (1 + marge), elle remonte
+static constexpr float QUALITY_SMOOTHING = 0.05f; // poids d'une frame dans la moyenne glissante
+static constexpr float QUALITY_DEGRADE_DELAY = 0.5f; // secondes au-dessus du seuil avant de baisser d'un niveau
+static constexpr float QUALITY_RESTORE_DELAY = 4.0f; // secondes sous le seuil avant de remonter d'un niveau
+static constexpr float QUALITY_RESTORE_DELAY_MAX = 32.0f; // attente maximale après des remontées ratées
+static constexpr int CHUNK_STREAM_RADIUS = 1; // morceaux chargés autour de celui de la caméra (fenêtre de 3 x 3 morceaux)
+
 static constexpr float PLAYER_MAX_HP = 100.0f;
 static constexpr float ENEMY_MAX_HP = 75.0f;
 static constexpr float BOSS_MAX_HP = 500.0f;
@@ -31,6 +65,8 @@ static constexpr float PLAYER_ATTACK_SPEED = 0.35f;
 static constexpr float ENEMY_ATTACK_SPEED = 0.65f;
 static constexpr float ENEMY_RANGE = 85.0f;
 static constexpr float ENEMY_DAMAGE = 15.0f;
+static constexpr int ENEMY_PATH_CLEARANCE = 2; // cases libres visées entre le chemin et les murs (voir Astar::BuildClearance)
+static constexpr int NAV_REPAIR_RADIUS = 8; // dégagement recalculé autour d'un obstacle posé ou retiré, au moins ENEMY_PATH_CLEARANCE
 
 static constexpr int BOSS_SPEED_IDLE = 125.0f;
 static constexpr int BOSS_SPEED_CHASE = 200.0f;
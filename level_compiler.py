@@ -0,0 +1,158 @@
+"""
+Précompile les hitbox JSON des niveaux en fichiers .lvl binaires lus sans analyse par le jeu (utilities_level.h) :
+rectangles de collision regroupés en grands rectangles, grille de navigation, dégagement autour des murs et points d'apparition/sortie.
+Le jeu cherche "<hitbox>.lvl" à côté du JSON et revient au JSON si le fichier manque ou est invalide.
+
+Format (little-endian) :
+    en-tête : "RLVL", u16 version, u16 drapeaux (1 = points renseignés), u32 somme FNV-1a des données,
+              u32 taille des données, u16 largeur, u16 hauteur de la grille, u32 nombre de rectangles,
+              f32 x, y d'apparition, f32 x, y de sortie
+    données : rectangles (i32 x, y, largeur, hauteur), grille (1 octet par case, 1 = mur),
+              dégagement (1 octet par case : distance en cases au mur le plus proche, diagonales comprises)
+
+Usage :
+    python3 level_compiler.py                                   # tous les niveaux du manifeste
+    python3 level_compiler.py hitbox.json [-o sortie.lvl] [--spawn X Y --exit X Y]
+
+Les points d'apparition et de sortie viennent de Assets/Levels/levels.json, sauf si --spawn/--exit sont donnés.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"RLVL"
+VERSION = 1
+FLAG_POINTS = 1
+GRID_SIZE = 100
+
+MANIFEST = "Assets/Levels/levels.json"
+
+
+def manifest_levels(path):
+    # hitbox JSON -> (apparition, sortie) de chaque niveau du manifeste (voir levels.h)
+    with open(path, encoding="utf-8") as f:
+        manifest = json.load(f)
+    levels = {}
+    for level in manifest["levels"]:
+        if level.get("hitbox"):
+            source = "Assets/Levels/" + level["folder"] + level["hitbox"]
+            levels[source] = (tuple(level["spawn"]), tuple(level["exit"]))
+    return levels
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def build_grid(rects, size):
+    grid = bytearray(size * size)
+    for x, y, w, h in rects:
+        for cy in range(max(0, y), min(size, y + h)):
+            for cx in range(max(0, x), min(size, x + w)):
+                grid[cy * size + cx] = 1
+    return grid
+
+
+def merge_rects(grid, size):
+    # recouvrement glouton, même calcul que MergeRects (utilities_rect.h) : chaque case pleine pas encore couverte
+    # démarre un rectangle étendu à droite puis vers le bas tant que les cases sont pleines
+    covered = bytearray(size * size)
+    merged = []
+    for y in range(size):
+        for x in range(size):
+            if not grid[y * size + x] or covered[y * size + x]:
+                continue
+            w = 1
+            while x + w < size and grid[y * size + x + w]:
+                w += 1
+            h = 1
+            while y + h < size and all(grid[(y + h) * size + x + i] for i in range(w)):
+                h += 1
+            for yy in range(y, y + h):
+                covered[yy * size + x:yy * size + x + w] = b"\x01" * w
+            merged.append((x, y, w, h))
+    return merged
+
+
+def build_clearance(grid, size):
+    # même calcul que Astar::BuildClearance : deux passes en 8-voisinage, plafonné à 255
+    c = bytearray(0 if cell else 255 for cell in grid)
+
+    def relax(x, y, nx, ny):
+        if 0 <= nx < size and 0 <= ny < size:
+            d = c[ny * size + nx] + 1
+            if d < c[y * size + x]:
+                c[y * size + x] = d
+
+    for y in range(size):
+        for x in range(size):
+            relax(x, y, x - 1, y)
+            relax(x, y, x - 1, y - 1)
+            relax(x, y, x, y - 1)
+            relax(x, y, x + 1, y - 1)
+    for y in reversed(range(size)):
+        for x in reversed(range(size)):
+            relax(x, y, x + 1, y)
+            relax(x, y, x + 1, y + 1)
+            relax(x, y, x, y + 1)
+            relax(x, y, x - 1, y + 1)
+    return c
+
+
+def compile_level(source, output, spawn=None, exit_=None):
+    with open(source, encoding="utf-8") as f:
+        items = json.load(f)
+    if not isinstance(items, list):
+        sys.exit(f"{source} : attendu un tableau de rectangles")
+    rects = [(int(r["x"]), int(r["y"]), int(r["width"]), int(r["height"])) for r in items]
+    compile_rects(rects, output, GRID_SIZE, spawn, exit_)
+
+
+def compile_rects(rects, output, size, spawn=None, exit_=None):
+    # rectangles en cases depuis le coin de la grille ; ceux qui dépassent sont coupés (voir chunk_builder.py)
+    grid = build_grid(rects, size)
+    merged = merge_rects(grid, size)
+    payload = b"".join(struct.pack("<iiii", *r) for r in merged) + bytes(grid) + bytes(build_clearance(grid, size))
+
+    flags = FLAG_POINTS if spawn is not None and exit_ is not None else 0
+    points = (*spawn, *exit_) if flags else (0.0, 0.0, 0.0, 0.0)
+    header = MAGIC + struct.pack("<HHIIHHI4f", VERSION, flags, fnv1a(payload), len(payload),
+                                 size, size, len(merged), *points)
+
+    with open(output, "wb") as out:
+        out.write(header + payload)
+    print(f"{output} : {len(rects)} -> {len(merged)} rectangles, {len(header) + len(payload)} octets")
+
+
+def default_output(source):
+    return source.rsplit(".", 1)[0] + ".lvl"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Précompile les hitbox JSON des niveaux en .lvl")
+    parser.add_argument("source", nargs="?", help="hitbox JSON (par défaut : tous les niveaux du manifeste)")
+    parser.add_argument("-o", "--output", help="fichier produit (par défaut : même chemin en .lvl)")
+    parser.add_argument("--spawn", nargs=2, type=float, metavar=("X", "Y"), help="point d'apparition du joueur")
+    parser.add_argument("--exit", nargs=2, type=float, metavar=("X", "Y"), help="position de la sortie")
+    parser.add_argument("--manifest", default=MANIFEST, help=f"manifeste des niveaux (par défaut : {MANIFEST})")
+    args = parser.parse_args()
+
+    levels = manifest_levels(args.manifest)
+    if args.source is None:
+        for source, (spawn, exit_) in levels.items():
+            compile_level(source, default_output(source), spawn, exit_)
+        return
+
+    spawn, exit_ = args.spawn, args.exit
+    if spawn is None and exit_ is None and args.source in levels:
+        spawn, exit_ = levels[args.source]
+    compile_level(args.source, args.output or default_output(args.source), spawn, exit_)
+
+
+if __name__ == "__main__":
+    main()
@@ -8,6 +8,7 @@
 #include <utilities_application.h>
 #include <utilities_math.h>
 #include <utilities_debug.h>
+#include <utilities_pack.h>
 #include <utilities_audio.h>
 
 #include <constants.h>
@@ -17,14 +18,28 @@
 #include <utilities_astar.h>
 
 #include <utilities_rect.h>
+#include <utilities_level.h>
 #include <utilities_time.h>
 #include <utilities_random.h>
+#include <utilities_sort.h>
+#include <utilities_textures.h>
+#include <utilities_loader.h>
+#include <utilities_atlas.h>
+#include <utilities_batch.h>
+#include <utilities_layercache.h>
+#include <utilities_resolution.h>
+#include <utilities_quality.h>
 #include <utilities_text.h>
+#include <utilities_cinematic.h>
+#include <utilities_video.h>
 #include <utilities_animations.h>
+#include <utilities_hotreload.h>
+#include <utilities_chunks.h>
 
 #include <slidevalue.h>
 
 #include <object.h>
+#include <components.h>
 #include <wall.h>
 #include <exit.h>
 
@@ -39,12 +54,15 @@
 
 #include <end_video.h>
 #include <triggerenemy.h>
+#include <obstacle.h>
 
 #include <entity.h>
 #include <player.h>
 #include <enemy.h>
+#include <levels.h>
 
 #include <mainmenu.h>
+#include <loadingscreen.h>
 
 using namespace std;
 
@@ -119,150 +137,146 @@ int main()
     Time::Init();
     Random::SetSeed(time(nullptr));
 
-    SoundManager::Instance().RegisterSound("swing_sword", "SwingSword.mp3");
-    SoundManager::Instance().RegisterSound("death", "Death.mp3");
-    SoundManager::Instance().RegisterSound("hit", "Hit.mp3");
-    SoundManager::Instance().RegisterSound("boss", "Boss.mp3");
-    SoundManager::Instance().RegisterSound("end_kill", "LastKill.mp3");
-    SoundManager::Instance().RegisterSound("boss_ost", "boss_ost.mp3");
-    SoundManager::Instance().RegisterSound("dojo_ost", "dojo_ost.mp3");
-    SoundManager::Instance().RegisterSound("hey", "Hey.mp3");
-    SoundManager::Instance().RegisterSound("main_menu", "Menu.mp3");
-    SoundManager::Instance().RegisterSound("boss_kill", "boss_kill.mp3");
-
-    SoundManager::Instance().PlaySound("main_menu", true, 0.5f);
-
     Scene &scene = Scene::Instance();
     Collision::CollisionSystem collisionSystem;
 
     auto cam = std::make_shared<Camera>();
     scene.SetCamera(cam);
+    scene.SetRenderMode(Y_SORTED_RENDERING ? RenderMode::YSorted : RenderMode::LayerOrder);
+
+    // chargement en arrière-plan : le menu s'affiche dès que son bundle est prêt, les niveaux suivent
+
+    // Assets.pak (asset_packer.py) si présent, fichiers libres sinon ; le rechargement à chaud lit les fichiers libres
+    if (!HOT_RELOAD)
+        AssetPack::Instance().Open(ASSET_PACK_PATH);
+
+    AssetLoader &loader = AssetLoader::Instance();
+    loader.Start();
+
+    auto loading_screen = scene.CreateObject<LoadingScreen>();
+    loading_screen->Init("menu");
+
+    std::shared_ptr<Player> player;
+
+    std::vector<std::string> playerImages = AnimationSet::AtlasPaths(Player::SPRITE_FOLDER, Player::Animations());
+    loader.Enqueue({"menu",
+                    {},
+                    {"Assets/game_over.png", "Assets/Shadow.png"},
+                    playerImages,
+                    {{"main_menu", "Menu.mp3"}},
+                    [&]()
+                    {
+                        SoundManager::Instance().PlaySound("main_menu", true, 0.5f);
+
+                        auto game_over = scene.CreateObject<GameOver>();
+                        game_over->Init(renderer);
+                        scene.SetGameOverObject(game_over);
+
+                        // player
+
+                        player = scene.CreateObject<Player>();
+                        player->InitPlayer(renderer);
+                        player->SetLayerOrder(ENTITY_LAYER);
+                        player->SetActive(true);
+
+                        scene.SetPlayer(player);
+
+                        auto main_menu = scene.CreateObject<MainMenu>();
+
+                        auto main_menu_lvl = scene.CreateLevel(0,
+                                                               renderer,
+                                                               {0, 0},
+                                                               {0, 0},
+                                                               "",
+                                                               {},
+                                                               {},
+                                                               "");
+                        main_menu_lvl->SetPlayerAllowed(false);
+                        main_menu->SetParent(main_menu_lvl.get());
+                        main_menu->Init(renderer);
+                        main_menu->SetActive(true);
+
+                        scene.SetLevel(0);
+                    }});
+
+    loader.Enqueue({"sounds",
+                    {},
+                    {},
+                    {},
+                    {{"swing_sword", "SwingSword.mp3"},
+                     {"death", "Death.mp3"},
+                     {"hit", "Hit.mp3"},
+                     {"boss", "Boss.mp3"},
+                     {"end_kill", "LastKill.mp3"},
+                     {"boss_ost", "boss_ost.mp3"},
+                     {"dojo_ost", "dojo_ost.mp3"},
+                     {"hey", "Hey.mp3"},
+                     {"boss_kill", "boss_kill.mp3"}},
+                    nullptr});
+
+    // levels : décrits par le manifeste, créés à la demande par Scene::SetLevel, le suivant est préchargé pendant la partie
+
+    LevelManifest manifest;
+    manifest.Load(LEVEL_MANIFEST_PATH);
+    auto registerLevels = [&]()
+    {
+        for (const LevelDefinition &def : manifest.Levels())
+        {
+            AssetBundle bundle = manifest.Bundle(def, {"menu", "sounds"});
+            // copie : le manifeste peut être remplacé pendant le chargement
+            bundle.onReady = [&, def]()
+            {
+                manifest.Build(def, renderer, player);
+            };
+            scene.RegisterLevel(def.index, std::move(bundle));
+        }
+    };
+    registerLevels();
+
+    // rechargement à chaud : seuls les fichiers modifiés et les niveaux qui en dépendent sont repris
+
+    if (HOT_RELOAD)
+    {
+        HotReload &hotReload = HotReload::Instance();
+
+        auto reloadImage = [&](const std::string &path)
+        {
+            bool single = TextureCache::Instance().Reload(renderer, path);
+            bool atlased = Atlas::Reload(path);
+            if (!single && !atlased)
+                Debug::Log("HotReload: " + path + " is not loaded, nothing to do");
+            else
+                LayerCache::InvalidateAll();
+        };
+        hotReload.On(".png", reloadImage);
+        hotReload.On(".jpg", reloadImage);
+
+        hotReload.On(".lvl", [&](const std::string &path)
+        {
+            scene.ReloadLevelGeometry(path);
+        });
+        hotReload.On(".json", [&](const std::string &path)
+        {
+            if (path != LEVEL_MANIFEST_PATH)
+            {
+                scene.ReloadLevelGeometry(path);
+                return;
+            }
+
+            LevelManifest updated;
+            if (!updated.Load(path))
+                return; // manifeste invalide : l'ancien reste en place
+
+            std::vector<int> changed = manifest.ChangedLevels(updated);
+            manifest = std::move(updated);
+            registerLevels();
+            for (int index : changed)
+                scene.ReloadLevel(index);
+        });
+
+        hotReload.Start("Assets");
+    }
 
-    auto game_over = scene.CreateObject<GameOver>();
-    game_over->Init(renderer);
-    scene.SetGameOverObject(game_over);
-
-    // player
-
-    auto player = scene.CreateObject<Player>();
-    player->InitPlayer(renderer);
-    player->SetLayerOrder(900);
-    player->SetActive(true);
-
-    scene.SetPlayer(player);
-
-    auto main_menu = scene.CreateObject<MainMenu>();
-
-    // levels
-
-    auto main_menu_lvl = scene.CreateLevel(renderer,
-                                           {0, 0},
-                                           {0, 0},
-                                           "",
-                                           {},
-                                           {},
-                                           "");
-    main_menu_lvl->SetPlayerAllowed(false);
-    main_menu->SetParent(main_menu_lvl.get());
-    main_menu->Init(renderer);
-    main_menu->SetActive(true);
-
-    auto lvl0 = scene.CreateLevel(renderer,
-                                  {0, 400},
-                                  {0, -400},
-                                  "Level0/",
-                                  {"level_0.png"},
-                                  {"level_0_layer.png"},
-                                  "Assets/Levels/Level0/level_0_hitbox.json");
-
-    auto lvl1 = scene.CreateLevel(renderer,
-                                  {-400, 400},
-                                  {435, -400},
-                                  "Level1/",
-                                  {"level_1.png"},
-                                  {},
-                                  "Assets/Levels/Level1/level_1_hitbox.json");
-
-    auto lvl2 = scene.CreateLevel(renderer,
-                                  {0, 400},
-                                  {400, -440},
-                                  "Level2/",
-                                  {"level2_animated_0000.png", "level2_animated_0001.png", "level2_animated_0002.png", "level2_animated_0003.png", "level2_animated_0004.png", "level2_animated_0005.png", "level2_animated_0006.png"},
-                                  {},
-                                  "Assets/Levels/Level2/level_2_hitbox.json");
-
-    auto lvl3 = scene.CreateLevel(renderer,
-                                  {0, 400},
-                                  {0, -400},
-                                  "Level3/",
-                                  {"level_3.png"},
-                                  {},
-                                  "Assets/Levels/Level3/level_3_hitbox.json");
-
-    // enemies lvl 1
-
-    auto e1 = scene.CreateObject<Enemy>({80, -400});
-    e1->InitEnemy(renderer, {{45, -375}, {315, 0}});
-    e1->SetPlayer(player);
-    e1->SetGrid(lvl1->GetGrid());
-
-    auto e2 = scene.CreateObject<Enemy>({-375, -310});
-    e2->InitEnemy(renderer, {{-115, -350}, {-150, 0}});
-    e2->SetPlayer(player);
-    e2->SetGrid(lvl1->GetGrid());
-
-    auto e3 = scene.CreateObject<Enemy>({150, 175});
-    e3->InitEnemy(renderer, {{425, 400}, {-190, 400}, {425, 150}});
-    e3->SetPlayer(player);
-    e3->SetGrid(lvl1->GetGrid());
-
-    lvl1->SetEnemies({e1, e2, e3});
-
-    // enemies lvl 2
-
-    auto e4 = scene.CreateObject<Enemy>({-202, -136});
-    e4->InitEnemy(renderer, {});
-    e4->SetPlayer(player);
-    e4->SetGrid(lvl2->GetGrid());
-
-    auto e5 = scene.CreateObject<Enemy>({155, -163});
-    e5->InitEnemy(renderer, {});
-    e5->SetPlayer(player);
-    e5->SetGrid(lvl2->GetGrid());
-
-    auto e6 = scene.CreateObject<Enemy>({-212, 39});
-    e6->InitEnemy(renderer, {});
-    e6->SetPlayer(player);
-    e6->SetGrid(lvl2->GetGrid());
-
-    auto e7 = scene.CreateObject<Enemy>({195, 117});
-    e7->InitEnemy(renderer, {});
-    e7->SetPlayer(player);
-    e7->SetGrid(lvl2->GetGrid());
-
-    auto e8 = scene.CreateObject<Enemy>({-404, -228});
-    e8->InitEnemy(renderer, {{-400, 375}});
-    e8->SetPlayer(player);
-    e8->SetGrid(lvl2->GetGrid());
-
-    auto e9 = scene.CreateObject<Enemy>({404, -228});
-    e9->InitEnemy(renderer, {{400, 375}});
-    e9->SetPlayer(player);
-    e9->SetGrid(lvl2->GetGrid());
-
-    lvl2->SetEnemies({e4, e5, e6, e7, e8, e9});
-
-    // boss lvl 3
-
-    auto boss = scene.CreateObject<Enemy>({0, -400});
-    boss->InitEnemy(renderer, {}, true);
-    boss->SetPlayer(player);
-    boss->SetGrid(lvl3->GetGrid());
-
-    lvl3->SetEnemies({boss});
-
-    scene.UpdateLayerOrder();
-    scene.SetLevel(0);
     bool gameRunning = true;
     SDL_Event e;
 
@@ -272,23 +286,55 @@ int main()
         {
             if (e.type == SDL_QUIT)
                 gameRunning = false;
+            // contenu des textures cibles perdu (changement de pilote, fenêtre déplacée sur un autre écran...)
+            if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET)
+                LayerCache::InvalidateAll();
 
         }
 
         Input::UpdateKeys(window);
         Time::Update();
 
+        // textures décodées en arrière-plan et objets des bundles prêts
+        loader.Pump(renderer, ASSET_UPLOAD_BUDGET_MS);
+        if (HOT_RELOAD)
+            HotReload::Instance().Poll();
+        scene.UpdateStreaming();
+
+        // monde en morceaux : la caméra suit le joueur et les morceaux autour d'elle sont chargés ; une salle reste centrée
+        auto currentLevel = scene.GetCurrentLevel();
+        bool chunked = currentLevel && currentLevel->IsChunked();
+        cam->SetPosition(chunked && player ? player->GetWorldPosition() : Vector2D{0.0f, 0.0f});
+        if (chunked)
+            currentLevel->StreamChunks(cam->GetWorldPosition());
+
+        // décor du niveau courant pour les collisions et les raycasts (un monde en morceaux n'a que sa grille)
+        Collision::CurrentTiles() = (LEVEL_TILE_COLLISION || chunked) && currentLevel ? currentLevel->GetTileMap() : Collision::TileMap{};
+
         // window size
         int windowWidth, windowHeight;
         SDL_GetWindowSize(window, &windowWidth, &windowHeight);
         cam->SetViewportSize(windowWidth, windowHeight);
 
+        // travail réduit ou rendu selon la durée des frames (IA, chemins, animations, échelle de rendu)
+        if (QUALITY_GOVERNOR)
+            QualityGovernor::Instance().Update(Time::DeltaTime());
+
+        // résolution interne suivant la durée des frames : tout ce qui suit est dessiné dans la cible réduite
+        if (DYNAMIC_RESOLUTION)
+        {
+            DynamicResolution::Instance().Update(Time::DeltaTime());
+            DynamicResolution::Instance().Begin(renderer);
+        }
+
         // clear
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
 
         // logique du jeu
+        Combat::UpdateAttacks(Time::DeltaTime());
         scene.UpdateAll(Time::DeltaTime());
+        Animations::UpdatePlayers(Time::DeltaTime());
 
         // collisions
         collisionSystem.SetObjects(scene.GetRawObjectPointers());
@@ -297,20 +343,29 @@ int main()
         // rendu
 
         scene.RenderAll(renderer);
+        if (DYNAMIC_RESOLUTION)
+            DynamicResolution::Instance().End(renderer);
 
-        // render fps text
+        // render fps text, à la résolution de la fenêtre
 
-        /*
-
-        Text::WriteText(renderer, defFont, to_string(Time::GetAverageFPS()) + " FPS", 0, 0, Text::Anchor::TOP_RIGHT, Text::Anchor::TOP_RIGHT);
-
-        Text::WriteText(renderer, defFont, "Position : (" + to_string(player->GetWorldPosition().x) + ", " + to_string(player->GetWorldPosition().y) + ")", 0, 0, Text::Anchor::TOP_LEFT, Text::Anchor::TOP_LEFT);
-        Text::WriteText(renderer, defFont, "Auto-lock : " + to_string(player->AutoLock()), 0, 30, Text::Anchor::TOP_LEFT, Text::Anchor::TOP_LEFT);
-
-        */
+        if (SHOW_DEBUG_OVERLAY && player)
+        {
+            Text::WriteText(renderer, defFont, to_string(Time::GetAverageFPS()) + " FPS", 0, 0, Text::Anchor::TOP_RIGHT, Text::Anchor::TOP_RIGHT);
+
+            Text::WriteText(renderer, defFont, "Position : (" + to_string(player->GetWorldPosition().x) + ", " + to_string(player->GetWorldPosition().y) + ")", 0, 0, Text::Anchor::TOP_LEFT, Text::Anchor::TOP_LEFT);
+            Text::WriteStaticText(renderer, defFont, "Auto-lock : " + to_string(player->AutoLock()), 0, 30, Text::Anchor::TOP_LEFT, Text::Anchor::TOP_LEFT);
+            if (DYNAMIC_RESOLUTION)
+            {
+                DynamicResolution &resolution = DynamicResolution::Instance();
+                Text::WriteText(renderer, defFont, "Resolution : " + to_string((int)std::lround(resolution.Scale() * 100)) + "% (" + to_string((int)std::lround(resolution.AverageFrameMs())) + " / " + to_string((int)std::lround(resolution.TargetMs())) + " ms)", 0, 60, Text::Anchor::TOP_LEFT, Text::Anchor::TOP_LEFT);
+            }
+            if (QUALITY_GOVERNOR)
+                Text::WriteText(renderer, defFont, "Qualite : niveau " + to_string(QualityGovernor::Instance().CurrentLevel()), 0, 90, Text::Anchor::TOP_LEFT, Text::Anchor::TOP_LEFT);
+        }
 
         // dessiner
 
+        SpriteBatch::Instance().EndFrame();
         SDL_RenderPresent(renderer);
 
         // détruire les objects
@@ -327,6 +382,8 @@ int main()
         SDL_Delay(5);
     }
 
+    loader.Shutdown();
+
     TTF_Quit();
     IMG_Quit();
 